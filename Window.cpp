@@ -1,6 +1,7 @@
 //
 // Window ֘Ȁ
 //
+#define _USE_MATH_DEFINES
 #include <cmath>
 #include "Window.h"
 
@@ -19,12 +20,34 @@ const GLfloat initialPosition[] = { 0.0f, 0.0f, 5.0f };
 // zC[ɂOړ̑x
 const GLfloat distanceStep(0.1f);
 
+// I𑜓x̏k̉
+const GLfloat minRenderScale(0.5f);
+
+// I𑜓x̏kڕWɋ߂Â銄 (GPU Ԃ͐t[xē̂ŏ߂Â)
+const GLfloat scaleGain(0.2f);
+
+// GPU ԂڕW炱̊ȓȂkςȂ
+const GLfloat budgetMargin(0.05f);
+
+//
+// EBhE쐬
+//
+GLFWwindow *Window::create(const char *title, int width, int height, bool offscreen)
+{
+  // ItXN[ŕ`Ƃ̓EBhE\Ȃ
+  glfwWindowHint(GLFW_VISIBLE, offscreen ? GL_FALSE : GL_TRUE);
+
+  return glfwCreateWindow(width, height, title, NULL, NULL);
+}
+
 //
 // RXgN^
 //
-Window::Window(const char *title, int width, int height)
-  : window(glfwCreateWindow(width, height, title, NULL, NULL))
-  , blightness(0), selection(0)
+Window::Window(const char *title, int width, int height, bool offscreen)
+  : window(create(title, width, height, offscreen))
+  , blightness(0), selection(0), recording(false), offscreen(offscreen)
+  , ondemand(false), dirty(true), framebuffer(0), width(width), height(height)
+  , budget(0.0f), renderScale(1.0f), scaledFramebuffer(0)
 {
   if (window == NULL)
   {
@@ -36,8 +59,8 @@ Window::Window(const char *title, int width, int height)
   // ݂̃EBhEΏۂɂ
   glfwMakeContextCurrent(window);
 
-  // 쐬EBhEɑ΂ݒ
-  glfwSwapInterval(1);
+  // 쐬EBhEɑ΂ݒ (ItXN[ł͐҂Ȃ)
+  glfwSwapInterval(offscreen ? 0 : 1);
 
   // Q[OtBbNX_̓sɂƂÂ
   ggInit();
@@ -51,12 +74,45 @@ Window::Window(const char *title, int width, int height)
   // }EX{^𑀍삵Ƃ̏
   glfwSetMouseButtonCallback(window, mouse);
 
+  // }EX𓮂Ƃ̏
+  glfwSetCursorPosCallback(window, motion);
+
   // }EXzC[쎞ɌĂяo
   glfwSetScrollCallback(window, wheel);
 
+  // EBhE̓eꂽƂ̏
+  glfwSetWindowRefreshCallback(window, refresh);
+
   // EBhẼTCYύXɌĂяoo^
   glfwSetFramebufferSizeCallback(window, resize);
 
+  // ItXN[ŕ`Ƃ̓EBhEƓ傫̃t[obt@IuWFNgɕ`
+  if (offscreen)
+  {
+    glGenRenderbuffers(2, renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffer[1]);
+
+    // t[obt@IuWFNggȂΏI
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+      std::cerr << "Can't create offscreen framebuffer." << std::endl;
+      exit(1);
+    }
+
+    // `ƓǂݏȏΏۂɂ
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+  }
+
   // J̏ʒuݒ肷
   position[0] = -initialPosition[0];
   position[1] = -initialPosition[1];
@@ -71,20 +127,162 @@ Window::Window(const char *title, int width, int height)
 //
 Window::~Window()
 {
+  // kĕ`t[obt@IuWFNg폜
+  setBudget(0.0f);
+
+  // ItXN[̃t[obt@IuWFNg폜
+  if (framebuffer != 0)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(2, renderbuffer);
+  }
+
   glfwDestroyWindow(window);
 }
 
+//
+// ʃNA
+//
+void Window::clear() const
+{
+  // I𑜓xȂk傫ŕ`
+  if (scaledFramebuffer != 0)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, scaledFramebuffer);
+    glViewport(0, 0, getScaledWidth(), getScaledHeight());
+
+    // glClear() ̓r[|[gɊ֌WȂobt@Ŝ̂, kĕ`͈͂
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, getScaledWidth(), getScaledHeight());
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+    return;
+  }
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+//
+// kĕ`摜EBhȆ傫Ɋg傷
+//
+void Window::upscale() const
+{
+  if (scaledFramebuffer == 0) return;
+
+  // kĕ``ԂŊg債ăEBhE (ItXN[Ȃ炻̃t[obt@IuWFNg) ɓ]
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, scaledFramebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+  glBlitFramebuffer(0, 0, getScaledWidth(), getScaledHeight(), 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+  // `ƓǂݏȏΏۂƃr[|[gɖ߂
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, width, height);
+}
+
+//
+// I𑜓xŏkĕ`悤ɂ
+//
+void Window::setBudget(GLfloat budget)
+{
+  this->budget = budget > 0.0f ? budget : 0.0f;
+  renderScale = 1.0f;
+
+  // kȂȂt[obt@IuWFNg͎gȂ
+  if (this->budget == 0.0f)
+  {
+    if (scaledFramebuffer != 0)
+    {
+      glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+      glDeleteFramebuffers(1, &scaledFramebuffer);
+      glDeleteRenderbuffers(2, scaledRenderbuffer);
+      scaledFramebuffer = 0;
+    }
+    return;
+  }
+
+  // łɍĂΖڕWς邾
+  if (scaledFramebuffer != 0) return;
+
+  // }`TṽEBhEɂ͊g債ē]łȂ
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  GLint sampleBuffers;
+  glGetIntegerv(GL_SAMPLE_BUFFERS, &sampleBuffers);
+  if (sampleBuffers > 0)
+  {
+    std::cerr << "Warning: Dynamic resolution needs a single-sampled window. Rendering at full size." << std::endl;
+    this->budget = 0.0f;
+    return;
+  }
+
+  // EBhEƓ傫̃_[obt@, ̈ꕔɏkĕ`
+  glGenRenderbuffers(2, scaledRenderbuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, scaledRenderbuffer[0]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, scaledRenderbuffer[1]);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &scaledFramebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, scaledFramebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, scaledRenderbuffer[0]);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, scaledRenderbuffer[1]);
+  glDrawBuffer(GL_COLOR_ATTACHMENT0);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  const GLenum status(glCheckFramebufferStatus(GL_FRAMEBUFFER));
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+  // t[obt@IuWFNggȂΏkɕ`
+  if (status != GL_FRAMEBUFFER_COMPLETE)
+  {
+    std::cerr << "Warning: Can't create framebuffer for dynamic resolution. Rendering at full size." << std::endl;
+    setBudget(0.0f);
+  }
+}
+
+//
+// ߂ GPU ԂڕWɋ߂Â悤ɏk𒲐
+//
+void Window::adjustScale(double time, double fixed)
+{
+  if (budget <= 0.0f || time <= 0.0) return;
+
+  // ڕWkɂȂԂckɔႷ镔Ɋ蓖Ă
+  //   (kɂȂԂŖڕW𒴂Ă΍ŏ̏kɋ߂Â)
+  const double available(fixed > 0.0 ? budget - fixed : budget);
+
+  // ڕWƂ̍ΕςȂ (킸ȕϓŕ`傫hȂ悤ɂ)
+  const double ratio(available > 0.0 ? available / time : 0.0);
+  if (fabs(ratio - 1.0) < budgetMargin) return;
+
+  // GPU Ԃ͕`f (k̓) ɂقڔႷƂĖڕW̎ԂɂȂk, ɏ߂Â
+  const GLfloat target(renderScale * GLfloat(sqrt(ratio)));
+  renderScale += (target - renderScale) * scaleGain;
+  if (renderScale < minRenderScale) renderScale = minRenderScale;
+  else if (renderScale > 1.0f) renderScale = 1.0f;
+}
+
 //
 // J[obt@ւăCxgo
 //
 void Window::swapBuffers()
 {
+  // ItXN[ł͕\Cxg̏Ȃ
+  if (offscreen)
+  {
+    ggError("SwapBuffers");
+    return;
+  }
+
   // J[obt@ւ
   glfwSwapBuffers(window);
 
   // OpenGL ̃G[`FbN
   ggError("SwapBuffers");
 
+  // ̃t[͕`
+  dirty = false;
+
   // Cxgo
   glfwPollEvents();
 
@@ -100,6 +298,29 @@ void Window::swapBuffers()
   }
 }
 
+//
+// `vɂĂ, `Kv邩EBhE܂ŃCxg҂
+//
+void Window::waitEvents()
+{
+  // ItXN[█t[`Ƃ͑҂Ȃ (t[AĕۑĂԂ҂Ȃ)
+  if (offscreen || !ondemand) return;
+
+  // `Kv邩EBhE܂ŃCxg҂
+  while (!dirty && !recording && !glfwWindowShouldClose(window)) glfwWaitEvents();
+
+  // ҂ĂԂɓ}EẌʒu𒲂ׂ
+  double x, y;
+  glfwGetCursorPos(window, &x, &y);
+
+  // {^hbO
+  if (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_1))
+  {
+    // gbN{[]
+    tb.motion(static_cast<GLfloat>(x), static_cast<GLfloat>(y));
+  }
+}
+
 //
 // L[{[h^Cv̏
 //
@@ -112,9 +333,13 @@ void Window::keyboard(GLFWwindow *window, int key, int scancode, int action, int
   {
     if (action == GLFW_PRESS)
     {
+      // \ς邩Ȃ̂ŕ` (ESC L[ł[vɖ߂ďI𔻒肷)
+      instance->dirty = true;
+
       switch (key)
       {
         case GLFW_KEY_SPACE:
+          instance->recording = !instance->recording;
           break;
         case GLFW_KEY_BACKSPACE:
         case GLFW_KEY_DELETE:
@@ -151,6 +376,9 @@ void Window::mouse(GLFWwindow *window, int button, int action, int mods)
     double x, y;
     glfwGetCursorPos(window, &x, &y);
 
+    // gbN{[̏Ԃς̂ŕ`
+    instance->dirty = true;
+
     switch (button)
     {
       case GLFW_MOUSE_BUTTON_1:
@@ -176,6 +404,18 @@ void Window::mouse(GLFWwindow *window, int button, int action, int mods)
   }
 }
 
+//
+// }EX𓮂Ƃ̏
+//
+void Window::motion(GLFWwindow *window, double x, double y)
+{
+  // ̃CX^X this |C^𓾂
+  Window *const instance(static_cast<Window *>(glfwGetWindowUserPointer(window)));
+
+  // {^hbOȂgbN{[ŉ]̂ŕ` (] swapBuffers()  waitEvents() ŋ߂)
+  if (instance && glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_1)) instance->dirty = true;
+}
+
 //
 // }EXzC[쎞̏
 //
@@ -186,6 +426,9 @@ void Window::wheel(GLFWwindow *window, double x, double y)
 
   if (instance)
   {
+    // Jړ̂ŕ`
+    instance->dirty = true;
+
     if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL))
     {
       // Control L[Ă΍Eʒu𒲐
@@ -223,15 +466,46 @@ void Window::resize(GLFWwindow *window, int width, int height)
 
   if (instance)
   {
+    // `
+    instance->dirty = true;
+
     // EBhEŜr[|[gɂ
     glViewport(0, 0, width, height);
 
-    // eϊs
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    gluPerspective(fovy, GLdouble(width) / GLdouble(height), zNear, zFar);
+    // I𑜓xŏkĕ`_[obt@EBhEƓ傫ɂ (ŏƂ͕ςȂ)
+    instance->width = width;
+    instance->height = height;
+    if (instance->scaledFramebuffer != 0 && width > 0 && height > 0)
+    {
+      glBindRenderbuffer(GL_RENDERBUFFER, instance->scaledRenderbuffer[0]);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+      glBindRenderbuffer(GL_RENDERBUFFER, instance->scaledRenderbuffer[1]);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+      glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    }
+
+    // eϊsݒ肷 (VF[_ŕ`Ƃɂg)
+    instance->mp.loadPerspective(GLfloat(fovy * M_PI / 180.0), GLfloat(width) / GLfloat(height),
+      GLfloat(zNear), GLfloat(zFar));
+    ggMatrixMode(GL_PROJECTION);
+    ggLoadMatrixf(instance->mp.get());
+
+    // ʂ̍Ɖp狗 1 ̈ʒuł̉f̑傫߂
+    instance->scale = GLfloat(height * 0.5 / tan(fovy * 0.5 * M_PI / 180.0));
 
     // gbN{[͈̔͂ݒ肷
     instance->tb.region(width, height);
   }
 }
+
+//
+// EBhE̓eꂽƂ̏
+//
+void Window::refresh(GLFWwindow *window)
+{
+  // ̃CX^X this |C^𓾂
+  Window *const instance(static_cast<Window *>(glfwGetWindowUserPointer(window)));
+
+  // BĂȂǂ`
+  if (instance) instance->dirty = true;
+}
@@ -28,16 +28,65 @@ class Window
   // ]Sɑ΂J̈ʒu
   GLfloat position[3];
 
+  // _狗 1 ̈ʒuɂ钷 1 ̐̉ʏ̒ (f)
+  GLfloat scale;
+
+  // eϊs (VF[_ŕ`ƂɎg)
+  GgMatrix mp;
+
   // 邳
   int blightness;
 
   // IeNX`ԍ
   int selection;
 
+  // t[AĕۑȂ true
+  bool recording;
+
+  // ItXN[ŕ`Ȃ true
+  const bool offscreen;
+
+  // ωƂ`Ȃ true
+  bool ondemand;
+
+  // `Kv true
+  bool dirty;
+
+  // ItXN[ŕ`Ƃ̃t[obt@IuWFNgƃJ[^fvX̃_[obt@
+  GLuint framebuffer, renderbuffer[2];
+
+  // t[obt@̑傫
+  GLsizei width, height;
+
+  // I𑜓xŏkĕ`Ƃ GPU Ԃ̖ڕW (~b, 0 ȂkȂ)
+  GLfloat budget;
+
+  // I𑜓x̏k
+  GLfloat renderScale;
+
+  // kĕ`t[obt@IuWFNgƃJ[^fvX̃_[obt@
+  GLuint scaledFramebuffer, scaledRenderbuffer[2];
+
+  // kĕ`傫
+  GLsizei getScaledWidth() const
+  {
+    const GLsizei w(GLsizei(width * renderScale));
+    return w > 0 ? w : 1;
+  }
+  GLsizei getScaledHeight() const
+  {
+    const GLsizei h(GLsizei(height * renderScale));
+    return h > 0 ? h : 1;
+  }
+
+  // EBhE쐬
+  static GLFWwindow *create(const char *title, int width, int height, bool offscreen);
+
 public:
 
   // RXgN^
-  Window(const char *title = "Game Graphics", int width = 640, int height = 480);
+  //   offscreen  true Ȃ\ȂEBhE, ҂Ƀt[obt@IuWFNgɕ`
+  Window(const char *title = "Game Graphics", int width = 640, int height = 480, bool offscreen = false);
 
   // fXgN^
   virtual ~Window();
@@ -45,27 +94,73 @@ public:
   // EBhEׂ𔻒肷
   int shouldClose() const
   {
+    // ItXN[ŕ`Ƃ͌ĂяoI߂
+    if (offscreen) return GL_FALSE;
     return glfwWindowShouldClose(window) | glfwGetKey(window, GLFW_KEY_ESCAPE);
   }
 
   // ʃNA
-  void clear() const
+  //   I𑜓xȂkĕ`t[obt@IuWFNg`̑ΏۂɂĂNA
+  void clear() const;
+
+  // kĕ`摜EBhȆ傫Ɋg傷 (I𑜓xłȂΉȂ)
+  //   t[ۑƂ͂̌ōs
+  void upscale() const;
+
+  // I𑜓xŏkĕ`悤ɂ
+  //   budget ̓V[̕` GPU Ԃ̖ڕW (~b) , 0 ȂkȂ
+  void setBudget(GLfloat budget);
+
+  // ߂ GPU  (~b) ڕWɋ߂Â悤ɏk𒲐 (̒lȂ牽Ȃ)
+  //   time ͕`fɔႷ镔 GPU , fixed ͊gȂǂ̏kɂȂ GPU 
+  void adjustScale(double time, double fixed = 0.0);
+
+  // I𑜓x GPU Ԃ̖ڕWo
+  GLfloat getBudget() const
   {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    return budget;
+  }
+
+  // I𑜓x̏ko
+  GLfloat getRenderScale() const
+  {
+    return renderScale;
   }
 
   // J[obt@ւăCxgo
   void swapBuffers();
 
+  // `vɂĂ, `Kv܂ŃCxg҂
+  //   t[̌vɊ܂߂Ȃ悤Ƀt[̕`n߂OɌĂ
+  void waitEvents();
+
+  // `vɂ (false Ȃ疈t[`)
+  void setOnDemand(bool flag)
+  {
+    ondemand = flag;
+  }
+
+  // ̃t[`悤ɂ (eNX`XVƂȂǂɌĂ)
+  void redisplay()
+  {
+    dirty = true;
+  }
+
   // L[{[h^Cv̏
   static void keyboard(GLFWwindow *window, int key, int scancode, int action, int mods);
 
   // }EX{^𑀍삵Ƃ̏
   static void mouse(GLFWwindow *window, int button, int action, int mods);
 
+  // }EX𓮂Ƃ̏
+  static void motion(GLFWwindow *window, double x, double y);
+
   // }EXzC[쎞̏
   static void wheel(GLFWwindow *window, double x, double y);
 
+  // EBhE̓eꂽƂ̏
+  static void refresh(GLFWwindow *window);
+
   // EBhẼTCYύX̏
   static void resize(GLFWwindow *window, int width, int height);
 
@@ -81,12 +176,34 @@ public:
     return tb.getMatrix().transpose().get();
   }
 
+  // J̈ʒuƉ]ݒ肷 (ItXN[̃x`}[NŃJ𓮂ƂɎg)
+  void setView(GLfloat x, GLfloat y, GLfloat z, const GgQuaternion &q)
+  {
+    position[0] = x;
+    position[1] = y;
+    position[2] = z;
+    tb.reset();
+    tb.rotate(q);
+  }
+
   // ]Sɑ΂J̈ʒuo
   const GLfloat *getPosition() const
   {
     return position;
   }
 
+  // _狗 1 ̈ʒuɂ钷 1 ̐̉ʏ̒o
+  GLfloat getScale() const
+  {
+    return scale;
+  }
+
+  // eϊso
+  const GgMatrix &getMp() const
+  {
+    return mp;
+  }
+
   // 邳o
   void getBrightness(GLfloat *brightness)
   {
@@ -99,4 +216,10 @@ public:
   {
     return selection;
   }
+
+  // t[Aĕۑ邩ǂ𒲂ׂ
+  bool isRecording() const
+  {
+    return recording;
+  }
 };
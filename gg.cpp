@@ -27,13 +27,46 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cmath>
 #include <cfloat>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
+#include <queue>
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// t@C̃}bv
+#if defined(_WIN32)
+#  define NOMINMAX
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#  include <sys/types.h>
+#  include <sys/stat.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+// SIMD 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#endif
+
+// Ԃ̃LbVŌŒ@\̊֐ (glTexEnv*() Ȃ) g
+#if defined(__APPLE__)
+#  define GL_DO_NOT_WARN_IF_MULTI_GL_VERSION_HEADERS_INCLUDED
+#  include <OpenGL/gl.h>
+#endif
 
 // NX`
 #include "gg.h"
@@ -5224,385 +5257,4188 @@ bool gg::ggSaveDepth(const char *name)
   return ggSaveTga(viewport[2], viewport[3], 1, &buffer[0], name);
 }
 
-/*!
-** \brief TGA t@C (8/16/24/32bit) ǂݍ.
-**
-**   \param name ǂݍރt@C.
-**   \param width ǂݍ񂾃t@C̕.
-**   \param height ǂݍ񂾃t@C̍.
-**   \param format ǂݍ񂾃t@C̃tH[}bg.
-**   \return ǂݍ񂾉摜f[^̃|C^ (v delete, ǂݍ߂Ȃ nullptr)
+/*
+** 񓯊t[Lv`Ft@C݂̏sXbh
 */
-GLubyte *gg::ggLoadTga(const char *name, GLsizei *width, GLsizei *height, GLenum *format)
+struct gg::GgCapture::Writer
 {
-  // t@CJ
-  std::ifstream file(name, std::ios::binary);
-
-  // t@CJȂ߂
-  if (!file)
+  // ݂҂t[
+  struct Frame
   {
-    std::cerr << "Error: Can't open file: " << name << std::endl;
-    return nullptr;
-  }
+    std::string name;
+    GLsizei width, height;
+    unsigned int depth;
+    std::vector<GLubyte> pixels;
+  };
 
-  // wb_ǂݍ
-  unsigned char header[18];
-  file.read(reinterpret_cast<char *>(header), sizeof header);
+  // ݂҂t[̑҂s
+  std::deque<Frame> queue;
 
-  // wb_̓ǂݍ݂Ɏs߂
-  if (file.bad())
+  // ҂sɕێt[̏
+  const size_t limit;
+
+  // ݒ̃t[
+  unsigned int busy;
+
+  // Xbh̏Iv
+  bool quit;
+
+  // ҂s̔r
+  mutable std::mutex mutex;
+
+  // ҂s̕ω̒ʒm
+  std::condition_variable changed;
+
+  // ݂sXbh
+  std::thread thread;
+
+  // RXgN^
+  Writer(size_t limit)
+    : limit(limit > 0 ? limit : 1), busy(0), quit(false)
   {
-    std::cerr << "Error: Can't read file header: " << name << std::endl;
-    file.close();
-    return nullptr;
+    thread = std::thread(&Writer::run, this);
   }
 
-  // ƍ
-  *width = header[13] << 8 | header[12];
-  *height = header[15] << 8 | header[14];
-
-  // [x
-  const size_t depth(header[16] / 8);
-  switch (depth)
+  // fXgN^
+  ~Writer()
   {
-  case 1:
-    *format = GL_RED;
-    break;
-  case 2:
-    *format = GL_RG;
-    break;
-  case 3:
-    *format = GL_BGR;
-    break;
-  case 4:
-    *format = GL_BGRA;
-    break;
-  default:
-    // 舵ȂtH[}bg߂
-    std::cerr << "Error: Unusable format: " << depth << std::endl;
-    file.close();
-    return nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+    }
+    changed.notify_all();
+    thread.join();
   }
 
-  // f[^TCY
-  const size_t size(*width * *height * depth);
+  // t[҂sɒǉ (҂s񂪈tȂ󂭂̂҂)
+  void push(Frame &frame)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (queue.size() >= limit) changed.wait(lock);
+    queue.push_back(Frame());
+    queue.back().name.swap(frame.name);
+    queue.back().width = frame.width;
+    queue.back().height = frame.height;
+    queue.back().depth = frame.depth;
+    queue.back().pixels.swap(frame.pixels);
+    lock.unlock();
+    changed.notify_all();
+  }
 
-  // ǂݍ݂Ɏgmۂ
-  GLubyte *const buffer(new(std::nothrow) GLubyte[size]);
+  // ҂s񂪋ɂȂ菑݂Î҂
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!queue.empty() || busy > 0) changed.wait(lock);
+  }
 
-  // mۂłȂΖ߂
-  if (buffer == nullptr)
+  // ݂ĂȂt[
+  unsigned int pending() const
   {
-    std::cerr << "Error: Too large file: " << name << std::endl;
-    file.close();
-    return nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<unsigned int>(queue.size()) + busy;
   }
 
-  // f[^ǂݍ
-  if (header[2] & 8)
+  // Xbh̏
+  void run()
   {
-    // RLE
-    size_t p(0);
-    char c;
-    while (file.get(c))
+    for (;;)
     {
-      if (c & 0x80)
+      // ҂s񂩂t[o
+      Frame frame;
       {
-        // run-length packet
-        const size_t count((c & 0x7f) + 1);
-        if (p + count * depth > size) break;
-        char tmp[4];
-        file.read(tmp, depth);
-        for (size_t i = 0; i < count; ++i)
-        {
-          for (size_t j = 0; j < depth;) buffer[p++] = tmp[j++];
-        }
+        std::unique_lock<std::mutex> lock(mutex);
+        while (queue.empty() && !quit) changed.wait(lock);
+        if (queue.empty()) break;
+        frame.name.swap(queue.front().name);
+        frame.width = queue.front().width;
+        frame.height = queue.front().height;
+        frame.depth = queue.front().depth;
+        frame.pixels.swap(queue.front().pixels);
+        queue.pop_front();
+        ++busy;
       }
-      else
+      changed.notify_all();
+
+      // t@Cɏ
+      ggSaveTga(frame.width, frame.height, frame.depth, &frame.pixels[0], frame.name.c_str());
+
+      // ݂
       {
-        // raw packet
-        const size_t count((c + 1) * depth);
-        if (p + count > size) break;
-        file.read(reinterpret_cast<char *>(buffer + p), count);
-        p += count;
+        std::lock_guard<std::mutex> lock(mutex);
+        --busy;
       }
+      changed.notify_all();
     }
   }
-  else
-  {
-    // 񈳏k
-    file.read(reinterpret_cast<char *>(buffer), size);
-  }
+};
 
-  // ǂݍ݂ɎsĂxo
-  if (file.bad())
+/*
+** 񓯊t[Lv`FRXgN^
+*/
+gg::GgCapture::GgCapture(GLenum format, unsigned int buffers, unsigned int queue)
+  : count(buffers < 2 ? 2 : buffers > maxBuffers ? maxBuffers : buffers)
+  , format(format == GL_DEPTH_COMPONENT ? GL_DEPTH_COMPONENT : GL_RGB)
+  , depth(format == GL_DEPTH_COMPONENT ? 1 : 3)
+  , head(0), used(0)
+  , writer(new Writer(queue))
+{
+  glGenBuffers(count, pbo);
+
+  for (unsigned int i = 0; i < count; ++i)
   {
-    std::cerr << "Waring: Can't read image data: " << name << std::endl;
+    capacity[i] = 0;
+    fence[i] = 0;
+    width[i] = height[i] = 0;
+    filename[i] = nullptr;
   }
+}
 
-  // t@C
-  file.close();
+/*
+** 񓯊t[Lv`FfXgN^
+*/
+gg::GgCapture::~GgCapture()
+{
+  // ǂݏõt[łI
+  flush();
+  delete writer;
 
-  // 摜ǂݍ񂾃Ԃ
-  return buffer;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glDeleteBuffers(count, pbo);
 }
 
-/*!
-** \brief eNX`mۂĉ摜ǂݍ.
-**
-**   \param width 摜̕.
-**   \param height 摜̍.
-**   \param internal eNX`̓tH[}bg.
-**   \param format 摜f[^̃tH[}bg.
-**   \param image 摜f[^.
-**   \return eNX`IuWFNg.
+/*
+** 񓯊t[Lv`FǂݏosNZobt@IuWFNg̓e݃Xbhɓn
 */
-GLuint gg::ggLoadTexture(GLsizei width, GLsizei height, GLenum internal,
-  GLenum format, const GLvoid *image)
+void gg::GgCapture::retrieve(unsigned int slot)
 {
-  // eNX`IuWFNg
-  GLuint tex;
-  glGenTextures(1, &tex);
-  glBindTexture(GL_TEXTURE_2D, tex);
-
-  // At@`lĂ 4 oCgEɐݒ肷
-  glPixelStorei(GL_UNPACK_ALIGNMENT, (format == GL_BGRA || format == GL_RGBA) ? 4 : 1);
+  // ǂݏo̊҂
+  while (glClientWaitSync(fence[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+  glDeleteSync(fence[slot]);
+  fence[slot] = 0;
+
+  // ݃Xbhɓnt[
+  Writer::Frame frame;
+  frame.name = filename[slot];
+  frame.width = width[slot];
+  frame.height = height[slot];
+  frame.depth = depth;
+
+  // sNZobt@IuWFNg}bvēeo
+  const size_t size(width[slot] * height[slot] * depth);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[slot]);
+  const GLubyte *const pixels(static_cast<const GLubyte *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT)));
+  if (pixels)
+  {
+    frame.pixels.assign(pixels, pixels + size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-  // eNX`蓖Ă
-  glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, format, GL_UNSIGNED_BYTE, image);
+  // t@C͂gȂ
+  delete[] filename[slot];
+  filename[slot] = nullptr;
+  --used;
 
-  // oCjAi~bv}bvȂjCGbWŃNv
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  // }bvłȂΏ܂Ȃ
+  if (frame.pixels.empty())
+  {
+    std::cerr << "Error: Can't map pixel buffer: " << frame.name << std::endl;
+    return;
+  }
 
-  // eNX`IuWFNgԂ
-  return tex;
+  // ݃Xbhɓn
+  writer->push(frame);
 }
 
-/*!
-** \brief TGA t@CeNX`ɓǂݍ.
-**
-**   \param name TGA t@C.
-**   \param internal eNX`̓tH[}bg.
-**   \return eNX`IuWFNg.
+/*
+** 񓯊t[Lv`F݂̃r[|[g̓e̓ǂݏoJn
 */
-GLuint gg::ggLoadImage(const char *name, GLenum internal)
+void gg::GgCapture::capture(const char *name)
 {
-  // 摜TCY
-  GLsizei width, height;
-
-  // 摜tH[}bg
-  GLenum format;
+  // ԌÂsNZobt@IuWFNgǂݏoĂ̂݃Xbhɓn
+  while (used > 0)
+  {
+    const unsigned int oldest((head + count - used) % count);
+    if (used < count && glClientWaitSync(fence[oldest], 0, 0) == GL_TIMEOUT_EXPIRED) break;
+    retrieve(oldest);
+  }
 
-  // 摜ǂݍ
-  const GLubyte *const image(ggLoadTga(name, &width, &height, &format));
+  // ݂̃r[|[g̃TCY𓾂
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
 
-  // 摜ǂݍ߂Ȃ߂
-  if (image == nullptr) return 0;
+  // ǂݏof[^ȂΖ߂
+  const GLsizeiptr size(viewport[2] * viewport[3] * depth);
+  if (size <= 0) return;
 
-  // internal == 0 ȂtH[}bgǂݍ񂾃t@Cɍ킹
-  if (internal == 0)
+  // sNZobt@IuWFNg̃TCYȂΊmۂ
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[head]);
+  if (capacity[head] < size)
   {
-    switch (format)
-    {
-    case GL_BGR:
-      internal = GL_RGB;
-      break;
-    case GL_BGRA:
-      internal = GL_RGBA;
-      break;
-    default:
-      internal = format;
-      break;
-    }
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    capacity[head] = size;
   }
 
-  // eNX`ɓǂݍ
-  const GLuint tex(ggLoadTexture(width, height, internal, format, image));
+  // s̋El߂ăsNZobt@IuWFNgɓǂݏo
+  GLint alignment;
+  glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(viewport[0], viewport[1], viewport[2], viewport[3],
+    format, GL_UNSIGNED_BYTE, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  // ǂݏo̊o铯IuWFNg}
+  fence[head] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  // ۑt@CƉ摜̃TCYL^
+  const size_t length(strlen(name) + 1);
+  filename[head] = new char[length];
+  std::copy(name, name + length, filename[head]);
+  width[head] = viewport[2];
+  height[head] = viewport[3];
+
+  // ̃sNZobt@IuWFNgɐi
+  head = (head + 1) % count;
+  ++used;
+}
 
-  // 摜̓ǂݍ݂Ɏg
-  delete[] image;
+/*
+** 񓯊t[Lv`Fǂݏõt[ׂĕۑ
+*/
+void gg::GgCapture::flush()
+{
+  // ǂݏõt[Âɏ݃Xbhɓn
+  while (used > 0) retrieve((head + count - used) % count);
 
-  // eNX`IuWFNgԂ
-  return tex;
+  // ݂̊҂
+  writer->wait();
 }
 
-/*!
-** \brief TGA 摜t@C̍}bvǂݍŃeNX`ɖ@}bv쐬.
-**
-**   \param name TGA t@C.
-**   \param nz 쐬@xNg z ̊.
-**   \param internal eNX`̓tH[}bg.
-**   \return eNX`IuWFNg.
+/*
+** 񓯊t[Lv`FۑĂȂt[
 */
-GLuint gg::ggLoadHeight(const char *name, float nz, GLenum internal)
+unsigned int gg::GgCapture::pending() const
 {
-  // 摜TCY
-  GLsizei width, height;
+  return used + writer->pending();
+}
 
-  // 摜tH[}bg
-  GLenum format;
+/*
+** t[̌vFԂƂ̌vl
+*/
+struct gg::GgProfiler::Scopes
+{
+  // ̋Ԃ̌vl
+  struct Scope
+  {
+    // Ԃ̖O
+    std::string name;
 
-  // }bv̉摜ǂݍ
-  const GLubyte *const hmap(ggLoadTga(name, &width, &height, &format));
+    // t[Ƃ̊JnƏI GPU ̎L^NG
+    GLuint query[latency][2];
 
-  // 摜ǂݍ߂Ȃ߂
-  if (hmap == nullptr) return 0;
+    // ̃t[ŃNG𔭍sĂ true
+    bool issued[latency];
 
-  // f̃oCg
-  int bytes;
-  switch (format)
-  {
-  case GL_RED:
-    bytes = 1;
-    break;
-  case GL_RG:
-    bytes = 2;
-    break;
-  case GL_BGR:
-    bytes = 3;
-    break;
-  case GL_BGRA:
-    bytes = 4;
-    break;
-  default:
-    bytes = 1;
-    break;
-  }
+    // Jn CPU ̎
+    std::chrono::steady_clock::time_point start;
 
-  // TCY
-  const GLsizei maxsize(width * height);
+    // ߂̃t[ CPU Ԃ GPU  (~b) Ƃꂼ̎ɏވʒu
+    std::vector<double> cpu, gpu;
+    size_t cpuHead, gpuHead;
+  };
 
-  // @}bṽmۂ
-  GLfloat (*const nmap)[4](new(std::nothrow) GLfloat[maxsize][4]);
+  //  (ŏɌv)
+  std::vector<Scope> scope;
 
-  // mۂłȂΖ߂
-  if (nmap == nullptr)
+  // t[ƂɋL^l
+  struct Value
   {
-    delete[] hmap;
-    return 0;
-  }
+    // l̖O
+    std::string name;
 
-  // @}bv̍쐬
-  for (GLsizei i = 0; i < maxsize; ++i)
-  {
+    // ߂̃t[̒lƎɏވʒu
+    std::vector<double> ring;
+    size_t head;
+  };
+
+  // L^l (ŏɋL^)
+  std::vector<Value> value;
+
+  // JnďIĂȂԂ̔ԍ
+  std::vector<size_t> stack;
+
+  // ݂̃t[̃NG̔ԍ
+  unsigned int slot;
+
+  // vt[
+  const size_t samples;
+
+  // RXgN^
+  Scopes(size_t samples)
+    : slot(0), samples(samples > 0 ? samples : 1)
+  {
+  }
+
+  // vl𒼋߂̃t[̌vlɉ
+  void push(std::vector<double> &ring, size_t &head, double time) const
+  {
+    if (ring.size() < samples)
+      ring.push_back(time);
+    else
+      ring[head] = time;
+    head = (head + 1) % samples;
+  }
+
+  // ŐԂ̔ԍT (Ȃ΍)
+  size_t find(const char *name)
+  {
+    for (size_t i = 0; i < scope.size(); ++i)
+      if (scope[i].name == name) return i;
+
+    scope.push_back(Scope());
+    Scope &s(scope.back());
+    s.name = name;
+    glGenQueries(latency * 2, s.query[0]);
+    std::fill(s.issued, s.issued + latency, false);
+    s.cpuHead = s.gpuHead = 0;
+    return scope.size() - 1;
+  }
+
+  // vl̐
+  static const int stats = 6;
+
+  // vl̍ŏl, ϒl, p50, p90, p99, ől߂
+  static void statistics(const std::vector<double> &ring, double *value)
+  {
+    if (ring.empty())
+    {
+      std::fill(value, value + stats, 0.0);
+      return;
+    }
+
+    std::vector<double> time(ring);
+    std::sort(time.begin(), time.end());
+    double sum(0.0);
+    for (size_t i = 0; i < time.size(); ++i) sum += time[i];
+    value[0] = time.front();
+    value[1] = sum / time.size();
+    value[2] = time[(time.size() - 1) * 50 / 100];
+    value[3] = time[(time.size() - 1) * 90 / 100];
+    value[4] = time[(time.size() - 1) * 99 / 100];
+    value[5] = time.back();
+  }
+
+  // ߂̃t[̌vl̂Ōɉ (ȂΕ̒l)
+  static double latest(const std::vector<double> &ring, size_t head)
+  {
+    if (ring.empty()) return -1.0;
+    return ring[(head + ring.size() - 1) % ring.size()];
+  }
+};
+
+/*
+** t[̌vFRXgN^
+*/
+gg::GgProfiler::GgProfiler(unsigned int samples)
+  : scopes(new Scopes(samples))
+{
+}
+
+/*
+** t[̌vFfXgN^
+*/
+gg::GgProfiler::~GgProfiler()
+{
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+    glDeleteQueries(latency * 2, scopes->scope[i].query[0]);
+  delete scopes;
+}
+
+/*
+** t[̌vFt[OɔsNǦʂǂݏo
+*/
+void gg::GgProfiler::retrieve(unsigned int slot)
+{
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+  {
+    Scopes::Scope &s(scopes->scope[i]);
+    if (!s.issued[slot]) continue;
+
+    GLuint64 start, stop;
+    glGetQueryObjectui64v(s.query[slot][0], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(s.query[slot][1], GL_QUERY_RESULT, &stop);
+    scopes->push(s.gpu, s.gpuHead, double(stop - start) * 1.0e-6);
+    s.issued[slot] = false;
+  }
+}
+
+/*
+** t[̌vFt[̌vJn
+*/
+void gg::GgProfiler::frame()
+{
+  // ̃t[̃NG latency t[OɔŝȂ̂Ōʂ͏oĂ͂
+  scopes->slot = (scopes->slot + 1) % latency;
+  retrieve(scopes->slot);
+}
+
+/*
+** t[̌vFԂ̌vJn
+*/
+void gg::GgProfiler::begin(const char *name)
+{
+  const size_t i(scopes->find(name));
+  scopes->stack.push_back(i);
+
+  Scopes::Scope &s(scopes->scope[i]);
+  glQueryCounter(s.query[scopes->slot][0], GL_TIMESTAMP);
+  s.start = std::chrono::steady_clock::now();
+}
+
+/*
+** t[̌vFŌɊJnԂ̌vI
+*/
+void gg::GgProfiler::end()
+{
+  if (scopes->stack.empty())
+  {
+    std::cerr << "Warning: GgProfiler::end() without begin()" << std::endl;
+    return;
+  }
+
+  Scopes::Scope &s(scopes->scope[scopes->stack.back()]);
+  scopes->stack.pop_back();
+
+  const std::chrono::duration<double, std::milli> elapsed(std::chrono::steady_clock::now() - s.start);
+  scopes->push(s.cpu, s.cpuHead, elapsed.count());
+  glQueryCounter(s.query[scopes->slot][1], GL_TIMESTAMP);
+  s.issued[scopes->slot] = true;
+}
+
+/*
+** t[̌vFsNǦʂׂēǂݏo
+*/
+void gg::GgProfiler::flush()
+{
+  // Ât[珇ɓǂݏo
+  for (unsigned int i = 1; i <= latency; ++i) retrieve((scopes->slot + i) % latency);
+}
+
+/*
+** t[̌vFvl
+*/
+void gg::GgProfiler::reset()
+{
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+  {
+    Scopes::Scope &s(scopes->scope[i]);
+    std::fill(s.issued, s.issued + latency, false);
+    s.cpu.clear();
+    s.gpu.clear();
+    s.cpuHead = s.gpuHead = 0;
+  }
+
+  for (size_t i = 0; i < scopes->value.size(); ++i)
+  {
+    scopes->value[i].ring.clear();
+    scopes->value[i].head = 0;
+  }
+}
+
+/*
+** t[̌vFԂ̒߂ GPU Ԃo
+*/
+double gg::GgProfiler::getGpuTime(const char *name) const
+{
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+  {
+    const Scopes::Scope &s(scopes->scope[i]);
+    if (s.name == name) return Scopes::latest(s.gpu, s.gpuHead);
+  }
+
+  return -1.0;
+}
+
+/*
+** t[̌vFt[Ƃ̒lL^
+*/
+void gg::GgProfiler::record(const char *name, double value)
+{
+  size_t i(0);
+  while (i < scopes->value.size() && scopes->value[i].name != name) ++i;
+
+  if (i == scopes->value.size())
+  {
+    scopes->value.push_back(Scopes::Value());
+    scopes->value.back().name = name;
+    scopes->value.back().head = 0;
+  }
+
+  Scopes::Value &v(scopes->value[i]);
+  scopes->push(v.ring, v.head, value);
+}
+
+/*
+** t[̌vFԂƂ CPU Ԃ GPU Ԃ̓v\
+*/
+void gg::GgProfiler::report()
+{
+  flush();
+
+  std::ios::fmtflags flags(std::cout.flags());
+  const std::streamsize precision(std::cout.precision());
+  std::cout << std::fixed << std::setprecision(3);
+  std::cout << std::left << std::setw(12) << "scope (ms)" << std::right
+    << std::setw(8) << "frames"
+    << std::setw(10) << "cpu min" << std::setw(10) << "cpu avg" << std::setw(10) << "cpu p50"
+    << std::setw(10) << "cpu p90" << std::setw(10) << "cpu p99"
+    << std::setw(10) << "gpu min" << std::setw(10) << "gpu avg" << std::setw(10) << "gpu p50"
+    << std::setw(10) << "gpu p90" << std::setw(10) << "gpu p99" << std::endl;
+
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+  {
+    const Scopes::Scope &s(scopes->scope[i]);
+    double cpu[Scopes::stats], gpu[Scopes::stats];
+    Scopes::statistics(s.cpu, cpu);
+    Scopes::statistics(s.gpu, gpu);
+    std::cout << std::left << std::setw(12) << s.name << std::right << std::setw(8) << s.cpu.size();
+    for (int j = 0; j < 5; ++j) std::cout << std::setw(10) << cpu[j];
+    for (int j = 0; j < 5; ++j) std::cout << std::setw(10) << gpu[j];
+    std::cout << std::endl;
+  }
+
+  if (!scopes->value.empty())
+  {
+    std::cout << std::left << std::setw(12) << "value" << std::right
+      << std::setw(8) << "frames"
+      << std::setw(10) << "min" << std::setw(10) << "avg" << std::setw(10) << "max" << std::endl;
+
+    for (size_t i = 0; i < scopes->value.size(); ++i)
+    {
+      const Scopes::Value &v(scopes->value[i]);
+      double value[Scopes::stats];
+      Scopes::statistics(v.ring, value);
+      std::cout << std::left << std::setw(12) << v.name << std::right
+        << std::setw(8) << v.ring.size()
+        << std::setw(10) << value[0] << std::setw(10) << value[1] << std::setw(10) << value[5] << std::endl;
+    }
+  }
+
+  std::cout.flags(flags);
+  std::cout.precision(precision);
+}
+
+/*
+** t[̌vFԂƂ CPU Ԃ GPU Ԃ̓v CSV t@Cɕۑ
+*/
+bool gg::GgProfiler::save(const char *name)
+{
+  flush();
+
+  std::ofstream file(name);
+  if (!file)
+  {
+    std::cerr << "Error: Can't open CSV file: " << name << std::endl;
+    return false;
+  }
+
+  file << "scope,frames,cpu_min,cpu_avg,cpu_p50,cpu_p90,cpu_p99,cpu_max,"
+    "gpu_min,gpu_avg,gpu_p50,gpu_p90,gpu_p99,gpu_max\n";
+  for (size_t i = 0; i < scopes->scope.size(); ++i)
+  {
+    const Scopes::Scope &s(scopes->scope[i]);
+    double cpu[Scopes::stats], gpu[Scopes::stats];
+    Scopes::statistics(s.cpu, cpu);
+    Scopes::statistics(s.gpu, gpu);
+    file << s.name << ',' << s.cpu.size();
+    for (int j = 0; j < Scopes::stats; ++j) file << ',' << cpu[j];
+    for (int j = 0; j < Scopes::stats; ++j) file << ',' << gpu[j];
+    file << '\n';
+  }
+
+  if (!scopes->value.empty())
+  {
+    file << "\nvalue,frames,min,avg,p50,p90,p99,max\n";
+    for (size_t i = 0; i < scopes->value.size(); ++i)
+    {
+      const Scopes::Value &v(scopes->value[i]);
+      double value[Scopes::stats];
+      Scopes::statistics(v.ring, value);
+      file << v.name << ',' << v.ring.size();
+      for (int j = 0; j < Scopes::stats; ++j) file << ',' << value[j];
+      file << '\n';
+    }
+  }
+
+  return static_cast<bool>(file);
+}
+
+// \cond STRUCT
+namespace gg
+{
+  // ̂ AABB ̒S̍W̑召ׂ (S 2 {Ŕׂ)
+  struct BvhCompare
+  {
+    const GLfloat (*bmin)[3];
+    const GLfloat (*bmax)[3];
+    int axis;
+
+    bool operator()(GLuint a, GLuint b) const
+    {
+      return bmin[a][axis] + bmax[a][axis] < bmin[b][axis] + bmax[b][axis];
+    }
+  };
+}
+// \endcond
+
+/*
+** JOFRXgN^
+*/
+gg::GgBvh::GgBvh()
+  : node(nullptr), nodes(0), object(nullptr), objects(0)
+{
+}
+
+/*
+** JOFfXgN^
+*/
+gg::GgBvh::~GgBvh()
+{
+  delete[] node;
+  delete[] object;
+}
+
+/*
+** JOFfirst Ԗڂ count ̂̕̕؂
+*/
+GLuint gg::GgBvh::subdivide(GLuint first, GLuint count, const GLfloat (*bmin)[3], const GLfloat (*bmax)[3])
+{
+  // ̕؂̍̐ߓ_
+  const GLuint n(nodes++);
+  node[n].first = first;
+  node[n].count = count;
+
+  // ̂ AABB ׂĊ܂ AABB , ̂ AABB ̒S܂ AABB (S 2 {̒lŋ߂)
+  GLfloat lower[3], upper[3], clower[3], cupper[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    lower[k] = clower[k] = FLT_MAX;
+    upper[k] = cupper[k] = -FLT_MAX;
+  }
+  for (GLuint i = first; i < first + count; ++i)
+  {
+    const GLuint o(object[i]);
+    for (int k = 0; k < 3; ++k)
+    {
+      lower[k] = std::min(lower[k], bmin[o][k]);
+      upper[k] = std::max(upper[k], bmax[o][k]);
+      const GLfloat c(bmin[o][k] + bmax[o][k]);
+      clower[k] = std::min(clower[k], c);
+      cupper[k] = std::max(cupper[k], c);
+    }
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    node[n].center[k] = (lower[k] + upper[k]) * 0.5f;
+    node[n].extent[k] = (upper[k] - lower[k]) * 0.5f;
+  }
+
+  // ̂Ȃtɂ
+  if (count == 1)
+  {
+    node[n].right = 0;
+    return n;
+  }
+
+  // S̕złL̒lœɕ
+  BvhCompare compare;
+  compare.bmin = bmin;
+  compare.bmax = bmax;
+  compare.axis = 0;
+  for (int k = 1; k < 3; ++k)
+    if (cupper[k] - clower[k] > cupper[compare.axis] - clower[compare.axis]) compare.axis = k;
+  const GLuint half(count / 2);
+  std::nth_element(object + first, object + first + half, object + first + count, compare);
+
+  // ̎q͎̐ߓ_ɂȂ
+  subdivide(first, half, bmin, bmax);
+  node[n].right = subdivide(first + half, count - half, bmin, bmax);
+
+  return n;
+}
+
+/*
+** JOF̂ AABB Kw
+*/
+void gg::GgBvh::build(GLuint count, const GLfloat (*bmin)[3], const GLfloat (*bmax)[3])
+{
+  delete[] node;
+  delete[] object;
+  node = nullptr;
+  object = nullptr;
+  nodes = 0;
+  objects = count;
+  if (count == 0) return;
+
+  // ẗ̓񕪖؂̐ߓ_̐ 2 * count - 1
+  node = new Node[2 * count - 1];
+
+  // ̂̔ԍבւȂ番
+  object = new GLuint[count];
+  for (GLuint i = 0; i < count; ++i) object[i] = i;
+  subdivide(0, count, bmin, bmax);
+}
+
+/*
+** JOFƌ镨̂I
+*/
+GLuint gg::GgBvh::cull(const GgMatrix &mc, GLuint *visible) const
+{
+  if (nodes == 0) return 0;
+
+  // NbsOWn̍sxNg r0`r3 獶EO̕ r3 } r0, r3 } r1, r3 } r2 ߂
+  // (W x, y, z, w Ƃ 4 ʂ܂Ƃ, c 2 ʂ͏ɓɂȂ悤ɂ)
+  const GLfloat *const m(mc.get());
+  GLfloat plane[4][8];
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      plane[k][i * 2] = m[k * 4 + 3] + m[k * 4 + i];
+      plane[k][i * 2 + 1] = m[k * 4 + 3] - m[k * 4 + i];
+    }
+  }
+  for (int j = 6; j < 8; ++j)
+  {
+    plane[0][j] = plane[1][j] = plane[2][j] = 0.0f;
+    plane[3][j] = 1.0f;
+  }
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  // ʂ̌W x, y, z ̌W̐Βl
+  const __m128 sign(_mm_set1_ps(-0.0f));
+  __m128 px[2], py[2], pz[2], pw[2], ax[2], ay[2], az[2];
+  for (int h = 0; h < 2; ++h)
+  {
+    px[h] = _mm_loadu_ps(plane[0] + h * 4);
+    py[h] = _mm_loadu_ps(plane[1] + h * 4);
+    pz[h] = _mm_loadu_ps(plane[2] + h * 4);
+    pw[h] = _mm_loadu_ps(plane[3] + h * 4);
+    ax[h] = _mm_andnot_ps(sign, px[h]);
+    ay[h] = _mm_andnot_ps(sign, py[h]);
+    az[h] = _mm_andnot_ps(sign, pz[h]);
+  }
+#endif
+
+  // ׂߓ_̃X^bN (lŕ̂Ő[͕̂̐ log2 xɎ܂)
+  GLuint stack[64];
+  int top(0);
+  stack[top++] = 0;
+
+  // ̂̐̕
+  GLuint count(0);
+
+  while (top > 0)
+  {
+    const Node &b(node[stack[--top]]);
+
+    // ʂ̊OɂΗrbg (out)  AABB ʂƌΗrbg (cross)
+    int out(0), cross(0);
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    const __m128 cx(_mm_set1_ps(b.center[0])), cy(_mm_set1_ps(b.center[1])), cz(_mm_set1_ps(b.center[2]));
+    const __m128 ex(_mm_set1_ps(b.extent[0])), ey(_mm_set1_ps(b.extent[1])), ez(_mm_set1_ps(b.extent[2]));
+    for (int h = 0; h < 2; ++h)
+    {
+      // ʂ AABB ̒S̋ d  AABB ̕ʂ̖@̔a r
+      const __m128 d(_mm_add_ps(_mm_add_ps(_mm_mul_ps(px[h], cx), _mm_mul_ps(py[h], cy)),
+        _mm_add_ps(_mm_mul_ps(pz[h], cz), pw[h])));
+      const __m128 r(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[h], ex), _mm_mul_ps(ay[h], ey)), _mm_mul_ps(az[h], ez)));
+      out |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(d, r), _mm_setzero_ps()));
+      cross |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(d, r), _mm_setzero_ps()));
+    }
+#else
+    for (int j = 0; j < 6; ++j)
+    {
+      const GLfloat d(plane[0][j] * b.center[0] + plane[1][j] * b.center[1] + plane[2][j] * b.center[2] + plane[3][j]);
+      const GLfloat r(fabs(plane[0][j]) * b.extent[0] + fabs(plane[1][j]) * b.extent[1] + fabs(plane[2][j]) * b.extent[2]);
+      if (d + r < 0.0f) out |= 1 << j;
+      if (d - r < 0.0f) cross |= 1 << j;
+    }
+#endif
+
+    // ǂꂩ̕ʂ̊OɂΌȂ
+    if (out != 0) continue;
+
+    // tSɓȂ畔؂ׂ̂̕ĉɂ
+    if (b.right == 0 || cross == 0)
+    {
+      std::copy(object + b.first, object + b.first + b.count, visible + count);
+      count += b.count;
+      continue;
+    }
+
+    // q̐ߓ_𒲂ׂ
+    stack[top++] = b.right;
+    stack[top++] = static_cast<GLuint>(&b - node) + 1;
+  }
+
+  return count;
+}
+
+/*!
+** \brief TGA t@C (8/16/24/32bit) ǂݍ.
+**
+**   \param name ǂݍރt@C.
+**   \param width ǂݍ񂾃t@C̕.
+**   \param height ǂݍ񂾃t@C̍.
+**   \param format ǂݍ񂾃t@C̃tH[}bg.
+**   \return ǂݍ񂾉摜f[^̃|C^ (v delete, ǂݍ߂Ȃ nullptr)
+*/
+GLubyte *gg::ggLoadTga(const char *name, GLsizei *width, GLsizei *height, GLenum *format)
+{
+  // t@CJ
+  std::ifstream file(name, std::ios::binary);
+
+  // t@CJȂ߂
+  if (!file)
+  {
+    std::cerr << "Error: Can't open file: " << name << std::endl;
+    return nullptr;
+  }
+
+  // wb_ǂݍ
+  unsigned char header[18];
+  file.read(reinterpret_cast<char *>(header), sizeof header);
+
+  // wb_̓ǂݍ݂Ɏs߂
+  if (file.bad())
+  {
+    std::cerr << "Error: Can't read file header: " << name << std::endl;
+    file.close();
+    return nullptr;
+  }
+
+  // ƍ
+  *width = header[13] << 8 | header[12];
+  *height = header[15] << 8 | header[14];
+
+  // [x
+  const size_t depth(header[16] / 8);
+  switch (depth)
+  {
+  case 1:
+    *format = GL_RED;
+    break;
+  case 2:
+    *format = GL_RG;
+    break;
+  case 3:
+    *format = GL_BGR;
+    break;
+  case 4:
+    *format = GL_BGRA;
+    break;
+  default:
+    // 舵ȂtH[}bg߂
+    std::cerr << "Error: Unusable format: " << depth << std::endl;
+    file.close();
+    return nullptr;
+  }
+
+  // f[^TCY
+  const size_t size(*width * *height * depth);
+
+  // ǂݍ݂Ɏgmۂ
+  GLubyte *const buffer(new(std::nothrow) GLubyte[size]);
+
+  // mۂłȂΖ߂
+  if (buffer == nullptr)
+  {
+    std::cerr << "Error: Too large file: " << name << std::endl;
+    file.close();
+    return nullptr;
+  }
+
+  // f[^ǂݍ
+  if (header[2] & 8)
+  {
+    // RLE
+    size_t p(0);
+    char c;
+    while (file.get(c))
+    {
+      if (c & 0x80)
+      {
+        // run-length packet
+        const size_t count((c & 0x7f) + 1);
+        if (p + count * depth > size) break;
+        char tmp[4];
+        file.read(tmp, depth);
+        for (size_t i = 0; i < count; ++i)
+        {
+          for (size_t j = 0; j < depth;) buffer[p++] = tmp[j++];
+        }
+      }
+      else
+      {
+        // raw packet
+        const size_t count((c + 1) * depth);
+        if (p + count > size) break;
+        file.read(reinterpret_cast<char *>(buffer + p), count);
+        p += count;
+      }
+    }
+  }
+  else
+  {
+    // 񈳏k
+    file.read(reinterpret_cast<char *>(buffer), size);
+  }
+
+  // ǂݍ݂ɎsĂxo
+  if (file.bad())
+  {
+    std::cerr << "Waring: Can't read image data: " << name << std::endl;
+  }
+
+  // t@C
+  file.close();
+
+  // 摜ǂݍ񂾃Ԃ
+  return buffer;
+}
+
+/*
+** TGA t@C̃wb_ǂݍŉ摜̑傫Ə𒲂ׂ
+*/
+static bool readTgaHeader(std::ifstream &file, const char *name, unsigned char *header,
+  GLsizei *width, GLsizei *height, size_t *depth, GLenum *format)
+{
+  // wb_ǂݍ
+  file.read(reinterpret_cast<char *>(header), 18);
+
+  // wb_̓ǂݍ݂Ɏs߂
+  if (file.fail())
+  {
+    std::cerr << "Error: Can't read file header: " << name << std::endl;
+    return false;
+  }
+
+  // ƍ
+  *width = header[13] << 8 | header[12];
+  *height = header[15] << 8 | header[14];
+
+  // [x
+  *depth = header[16] / 8;
+  switch (*depth)
+  {
+  case 1:
+    *format = GL_RED;
+    break;
+  case 2:
+    *format = GL_RG;
+    break;
+  case 3:
+    *format = GL_BGR;
+    break;
+  case 4:
+    *format = GL_BGRA;
+    break;
+  default:
+    // 舵ȂtH[}bg߂
+    std::cerr << "Error: Unusable format: " << *depth << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/*!
+** \brief TGA t@C (8/16/24/32bit) ̃wb_ǂݍ.
+**
+**   \param name ǂݍރt@C.
+**   \param width ǂݍ񂾃t@C̕.
+**   \param height ǂݍ񂾃t@C̍.
+**   \param format ǂݍ񂾃t@C̃tH[}bg.
+**   \return ǂݍ݂ɐ true, s false.
+*/
+bool gg::ggLoadTgaHeader(const char *name, GLsizei *width, GLsizei *height, GLenum *format)
+{
+  // t@CJ
+  std::ifstream file(name, std::ios::binary);
+
+  // t@CJȂ߂
+  if (!file)
+  {
+    std::cerr << "Error: Can't open file: " << name << std::endl;
+    return false;
+  }
+
+  // wb_ǂݍ
+  unsigned char header[18];
+  size_t depth;
+  return readTgaHeader(file, name, header, width, height, &depth, format);
+}
+
+/*!
+** \brief TGA t@C (8/16/24/32bit) ̋`̈悾ǂݍ.
+**
+**   \param name ǂݍރt@C.
+**   \param x ؂o`̈̍[̉fʒu.
+**   \param y ؂o`̈̍ŏ̍s̉fʒu.
+**   \param w ؂o`̈̕.
+**   \param h ؂o`̈̍.
+**   \param dw k̕.
+**   \param dh k̍.
+**   \param format ǂݍ񂾃t@C̃tH[}bg.
+**   \return ǂݍ񂾉摜f[^̃|C^ (v delete, ǂݍ߂Ȃ nullptr)
+*/
+GLubyte *gg::ggLoadTgaCrop(const char *name, GLsizei x, GLsizei y, GLsizei w, GLsizei h,
+  GLsizei dw, GLsizei dh, GLenum *format)
+{
+  // t@CJ
+  std::ifstream file(name, std::ios::binary);
+
+  // t@CJȂ߂
+  if (!file)
+  {
+    std::cerr << "Error: Can't open file: " << name << std::endl;
+    return nullptr;
+  }
+
+  // wb_ǂݍ
+  unsigned char header[18];
+  GLsizei width, height;
+  size_t depth;
+  if (!readTgaHeader(file, name, header, &width, &height, &depth, format))
+  {
+    file.close();
+    return nullptr;
+  }
+
+  // ؂o`̈摜̒Ɏ߂
+  const GLsizei x0(std::max(x, 0)), x1(std::min(x + w, width));
+  const GLsizei y0(std::max(y, 0)), y1(std::min(y + h, height));
+  if (x1 <= x0 || y1 <= y0)
+  {
+    std::cerr << "Error: Empty crop region: " << name << std::endl;
+    file.close();
+    return nullptr;
+  }
+  const GLsizei cw(x1 - x0), ch(y1 - y0);
+
+  // k̑傫
+  if (dw <= 0 || dw > cw) dw = cw;
+  if (dh <= 0 || dh > ch) dh = ch;
+
+  // 摜f[^̐擪̈ʒu (ID tB[hƃJ[}bvǂݔ΂)
+  const std::streamoff offset(18 + header[0]
+    + (header[1] != 0 ? (header[6] << 8 | header[5]) * ((header[7] + 7) / 8) : 0));
+  file.seekg(offset);
+
+  // ǂݍ݂Ɏgmۂ
+  const size_t size(static_cast<size_t>(dw) * dh * depth);
+  GLubyte *const buffer(new(std::nothrow) GLubyte[size]());
+
+  // mۂłȂΖ߂
+  if (buffer == nullptr)
+  {
+    std::cerr << "Error: Too large crop region: " << name << std::endl;
+    file.close();
+    return nullptr;
+  }
+
+  // RLE kĂ true
+  const bool rle((header[2] & 8) != 0);
+
+  // s̉f (RLE ȂsŜWJ)
+  std::vector<GLubyte> row((rle ? width : cw) * depth);
+
+  // kƂ
+  const bool scale(dw != cw || dh != ch);
+
+  // ̉f̗ɑΉk̗, k̗ɓ錳̉f̗
+  std::vector<GLsizei> column(scale ? cw : 0);
+  std::vector<GLuint> columns(scale ? dw : 0);
+  for (GLsizei sx = 0; sx < static_cast<GLsizei>(column.size()); ++sx)
+  {
+    column[sx] = sx * dw / cw;
+    ++columns[column[sx]];
+  }
+
+  // k̈s̉fl̍v, ɉ̉f̍s
+  std::vector<GLuint> sum(scale ? dw * depth : 0);
+  GLuint rows(0);
+
+  // RLE ̃pPbg̎c̉f, l̉fpPbgȂ炻̒l
+  GLsizei remaining(0);
+  bool run(false);
+  GLubyte pixel[4];
+
+  // ؂o`̈̍Ō̍s܂œǂݍ
+  for (GLsizei sy = rle ? 0 : y0; sy < y1; ++sy)
+  {
+    // ̍s̐؂o͈͂̐擪
+    const GLubyte *src;
+
+    if (rle)
+    {
+      // RLE sWJ
+      for (GLsizei i = 0; i < width && file;)
+      {
+        // ̃pPbg̃wb_ǂ
+        if (remaining == 0)
+        {
+          char c;
+          if (!file.get(c)) break;
+          remaining = (c & 0x7f) + 1;
+          run = (c & 0x80) != 0;
+          if (run) file.read(reinterpret_cast<char *>(pixel), depth);
+        }
+
+        // pPbĝ̍sɓf
+        const GLsizei n(std::min(remaining, width - i));
+        if (run)
+        {
+          for (GLsizei k = 0; k < n; ++k) memcpy(&row[(i + k) * depth], pixel, depth);
+        }
+        else
+        {
+          file.read(reinterpret_cast<char *>(&row[i * depth]), n * depth);
+        }
+        i += n;
+        remaining -= n;
+      }
+
+      // ؂o`̈O̍s͓ǂݎ̂Ă
+      if (sy < y0) continue;
+      src = &row[x0 * depth];
+    }
+    else
+    {
+      // 񈳏kȂ؂o͈͂ǂݍ
+      file.seekg(offset + (static_cast<std::streamoff>(sy) * width + x0) * depth);
+      file.read(reinterpret_cast<char *>(&row[0]), cw * depth);
+      src = &row[0];
+    }
+
+    // ǂݍ݂ɎsĂxođł؂
+    if (!file)
+    {
+      std::cerr << "Waring: Can't read image data: " << name << std::endl;
+      break;
+    }
+
+    // kȂȂ炻̂܂܋l߂Ċi[
+    if (!scale)
+    {
+      memcpy(buffer + static_cast<size_t>(sy - y0) * cw * depth, src, cw * depth);
+      continue;
+    }
+
+    // k̗񂲂Ƃɉflv
+    for (GLsizei sx = 0; sx < cw; ++sx)
+    {
+      GLuint *const s(&sum[column[sx] * depth]);
+      for (size_t c = 0; c < depth; ++c) s[c] += src[sx * depth + c];
+    }
+    ++rows;
+
+    // k̍sς邩Ō̍sȂ畽ς߂Ċi[
+    const GLsizei dy((sy - y0) * dh / ch);
+    if (sy + 1 == y1 || (sy + 1 - y0) * dh / ch != dy)
+    {
+      GLubyte *const dst(buffer + static_cast<size_t>(dy) * dw * depth);
+      for (GLsizei dx = 0; dx < dw; ++dx)
+      {
+        const GLuint n(columns[dx] * rows);
+        for (size_t c = 0; c < depth; ++c) dst[dx * depth + c] = static_cast<GLubyte>((sum[dx * depth + c] + n / 2) / n);
+      }
+      std::fill(sum.begin(), sum.end(), 0);
+      rows = 0;
+    }
+  }
+
+  // t@C
+  file.close();
+
+  // 摜ǂݍ񂾃Ԃ
+  return buffer;
+}
+
+/*!
+** \brief eNX`mۂĉ摜ǂݍ.
+**
+**   \param width 摜̕.
+**   \param height 摜̍.
+**   \param internal eNX`̓tH[}bg.
+**   \param format 摜f[^̃tH[}bg.
+**   \param image 摜f[^.
+**   \return eNX`IuWFNg.
+*/
+GLuint gg::ggLoadTexture(GLsizei width, GLsizei height, GLenum internal,
+  GLenum format, const GLvoid *image)
+{
+  // eNX`IuWFNg
+  GLuint tex;
+  glGenTextures(1, &tex);
+  ggBindTexture(GL_TEXTURE_2D, tex);
+
+  // At@`lĂ 4 oCgEɐݒ肷
+  glPixelStorei(GL_UNPACK_ALIGNMENT, (format == GL_BGRA || format == GL_RGBA) ? 4 : 1);
+
+  // eNX`蓖Ă
+  glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, format, GL_UNSIGNED_BYTE, image);
+
+  // oCjAi~bv}bvȂjCGbWŃNv
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  // eNX`IuWFNgԂ
+  return tex;
+}
+
+/*!
+** \brief TGA t@CeNX`ɓǂݍ.
+**
+**   \param name TGA t@C.
+**   \param internal eNX`̓tH[}bg.
+**   \return eNX`IuWFNg.
+*/
+GLuint gg::ggLoadImage(const char *name, GLenum internal)
+{
+  // 摜TCY
+  GLsizei width, height;
+
+  // 摜tH[}bg
+  GLenum format;
+
+  // 摜ǂݍ
+  const GLubyte *const image(ggLoadTga(name, &width, &height, &format));
+
+  // 摜ǂݍ߂Ȃ߂
+  if (image == nullptr) return 0;
+
+  // internal == 0 ȂtH[}bgǂݍ񂾃t@Cɍ킹
+  if (internal == 0)
+  {
+    switch (format)
+    {
+    case GL_BGR:
+      internal = GL_RGB;
+      break;
+    case GL_BGRA:
+      internal = GL_RGBA;
+      break;
+    default:
+      internal = format;
+      break;
+    }
+  }
+
+  // eNX`ɓǂݍ
+  const GLuint tex(ggLoadTexture(width, height, internal, format, image));
+
+  // 摜̓ǂݍ݂Ɏg
+  delete[] image;
+
+  // eNX`IuWFNgԂ
+  return tex;
+}
+
+/*!
+** \brief TGA 摜t@C̍}bvǂݍŃeNX`ɖ@}bv쐬.
+**
+**   \param name TGA t@C.
+**   \param nz 쐬@xNg z ̊.
+**   \param internal eNX`̓tH[}bg.
+**   \return eNX`IuWFNg.
+*/
+GLuint gg::ggLoadHeight(const char *name, float nz, GLenum internal)
+{
+  // 摜TCY
+  GLsizei width, height;
+
+  // 摜tH[}bg
+  GLenum format;
+
+  // }bv̉摜ǂݍ
+  const GLubyte *const hmap(ggLoadTga(name, &width, &height, &format));
+
+  // 摜ǂݍ߂Ȃ߂
+  if (hmap == nullptr) return 0;
+
+  // f̃oCg
+  int bytes;
+  switch (format)
+  {
+  case GL_RED:
+    bytes = 1;
+    break;
+  case GL_RG:
+    bytes = 2;
+    break;
+  case GL_BGR:
+    bytes = 3;
+    break;
+  case GL_BGRA:
+    bytes = 4;
+    break;
+  default:
+    bytes = 1;
+    break;
+  }
+
+  // TCY
+  const GLsizei maxsize(width * height);
+
+  // @}bṽmۂ
+  GLfloat (*const nmap)[4](new(std::nothrow) GLfloat[maxsize][4]);
+
+  // mۂłȂΖ߂
+  if (nmap == nullptr)
+  {
+    delete[] hmap;
+    return 0;
+  }
+
+  // @}bv̍쐬
+  for (GLsizei i = 0; i < maxsize; ++i)
+  {
     const int x(i % width);
     const int y(i - x);
     const int o(i * bytes);
     const int u((y + (x + 1) % width) * bytes);
     const int v(((y + width) % maxsize + x) * bytes);
 
-    // אڂfƂ̒l̍@̐ɗp
-    const float nx(float(hmap[u] - hmap[o]));
-    const float ny(float(hmap[v] - hmap[o]));
+    // אڂfƂ̒l̍@̐ɗp
+    const float nx(float(hmap[u] - hmap[o]));
+    const float ny(float(hmap[v] - hmap[o]));
+
+    // @̒߂Ă
+    const float nl(sqrt(nx * nx + ny * ny + nz * nz));
+
+    // @߂
+    nmap[i][0] = nx / nl;
+    nmap[i][1] = ny / nl;
+    nmap[i][2] = nz / nl;
+    nmap[i][3] = hmap[o];
+  }
+
+  // }bv̉摜̓ǂݍ݂Ɏg
+  delete[] hmap;
+
+  // tH[}bg_eNX`łȂ [0,1] ɕϊ
+  if (
+    internal != GL_RGB16F  &&
+    internal != GL_RGBA16F &&
+    internal != GL_RGB32F  &&
+    internal != GL_RGBA32F
+    )
+  {
+    for (GLsizei i = 0; i < maxsize; ++i)
+    {
+      nmap[i][0] = nmap[i][0] * 0.5f + 0.5f;
+      nmap[i][1] = nmap[i][1] * 0.5f + 0.5f;
+      nmap[i][2] = nmap[i][2] * 0.5f + 0.5f;
+      nmap[i][3] *= 0.0039215686f; // == 1/255
+    }
+  }
+
+  // eNX`IuWFNg
+  GLuint tex;
+  glGenTextures(1, &tex);
+  ggBindTexture(GL_TEXTURE_2D, tex);
+
+  // nmap  GLfloat Ȃ̂ 4 oCgEɐݒ肷
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  // eNX`蓖Ă
+  glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, GL_RGBA, GL_FLOAT, nmap);
+
+  // oCjAi~bv}bvȂjCGbWŃNv
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+  // @}bv̍쐬Ɏg
+  delete[] nmap;
+
+  // eNX`IuWFNgԂ
+  return tex;
+}
+
+// \cond STRUCT
+/*
+** BC1 (DXT1) `̈k
+*/
+namespace gg
+{
+  // 8 bit ̐F 5 bit / 6 bit ɗʎq 565 `ɂ܂Ƃ߂
+  static inline GLushort packRGB565(float r, float g, float b)
+  {
+    const int r5(std::min(std::max(int(r * (31.0f / 255.0f) + 0.5f), 0), 31));
+    const int g6(std::min(std::max(int(g * (63.0f / 255.0f) + 0.5f), 0), 63));
+    const int b5(std::min(std::max(int(b * (31.0f / 255.0f) + 0.5f), 0), 31));
+    return static_cast<GLushort>(r5 << 11 | g6 << 5 | b5);
+  }
+
+  // 565 `̐F 8 bit ̐FɓWJ
+  static inline void unpackRGB565(GLushort c, float *rgb)
+  {
+    const int r5(c >> 11 & 31), g6(c >> 5 & 63), b5(c & 31);
+    rgb[0] = float(r5 << 3 | r5 >> 2);
+    rgb[1] = float(g6 << 2 | g6 >> 4);
+    rgb[2] = float(b5 << 3 | b5 >> 2);
+  }
+
+  // \F 4 F̃pbg, efɍł߂pbg̐F̃CfbNX߂
+  //   ߂l̓pbg̐FƂ̓덷̘a
+  static float selectBC1(const float (*px)[16], GLushort c0, GLushort c1, GLuint &indices)
+  {
+    // pbg (c0 > c1 Ȃ̂ 4 F[h)
+    float p[4][3];
+    unpackRGB565(c0, p[0]);
+    unpackRGB565(c1, p[1]);
+    for (int k = 0; k < 3; ++k)
+    {
+      p[2][k] = (2.0f * p[0][k] + p[1][k]) / 3.0f;
+      p[3][k] = (p[0][k] + 2.0f * p[1][k]) / 3.0f;
+    }
+
+    // ef̍ł߂pbg̐FƂ̋
+    GLuint best[16];
+    float error(0.0f);
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    // 4 f
+    __m128 sum(_mm_setzero_ps());
+    for (int i = 0; i < 16; i += 4)
+    {
+      const __m128 r(_mm_loadu_ps(px[0] + i));
+      const __m128 g(_mm_loadu_ps(px[1] + i));
+      const __m128 b(_mm_loadu_ps(px[2] + i));
+      __m128 dmin(_mm_set1_ps(FLT_MAX));
+      __m128i imin(_mm_setzero_si128());
+      for (int k = 0; k < 4; ++k)
+      {
+        const __m128 dr(_mm_sub_ps(r, _mm_set1_ps(p[k][0])));
+        const __m128 dg(_mm_sub_ps(g, _mm_set1_ps(p[k][1])));
+        const __m128 db(_mm_sub_ps(b, _mm_set1_ps(p[k][2])));
+        const __m128 d(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg)), _mm_mul_ps(db, db)));
+        const __m128i closer(_mm_castps_si128(_mm_cmplt_ps(d, dmin)));
+        imin = _mm_or_si128(_mm_andnot_si128(closer, imin), _mm_and_si128(closer, _mm_set1_epi32(k)));
+        dmin = _mm_min_ps(d, dmin);
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(best + i), imin);
+      sum = _mm_add_ps(sum, dmin);
+    }
+    float partial[4];
+    _mm_storeu_ps(partial, sum);
+    error = partial[0] + partial[1] + partial[2] + partial[3];
+#else
+    for (int i = 0; i < 16; ++i)
+    {
+      float dmin(FLT_MAX);
+      best[i] = 0;
+      for (int k = 0; k < 4; ++k)
+      {
+        const float dr(px[0][i] - p[k][0]), dg(px[1][i] - p[k][1]), db(px[2][i] - p[k][2]);
+        const float d(dr * dr + dg * dg + db * db);
+        if (d < dmin)
+        {
+          dmin = d;
+          best[i] = k;
+        }
+      }
+      error += dmin;
+    }
+#endif
+
+    // f i ̃CfbNX 2i rbgڂl߂
+    indices = 0;
+    for (int i = 0; i < 16; ++i) indices |= best[i] << (i * 2);
+
+    return error;
+  }
+
+  // 4x4 f̃ubNk
+  static void compressBlockBC1(const float (*px)[16], GLubyte *block)
+  {
+    // 
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < 3; ++k)
+    {
+      for (int i = 0; i < 16; ++i) mean[k] += px[k][i];
+      mean[k] /= 16.0f;
+    }
+
+    // Us
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i)
+    {
+      const float r(px[0][i] - mean[0]), g(px[1][i] - mean[1]), b(px[2][i] - mean[2]);
+      cov[0] += r * r;
+      cov[1] += r * g;
+      cov[2] += r * b;
+      cov[3] += g * g;
+      cov[4] += g * b;
+      cov[5] += b * b;
+    }
+
+    // ׂ@Ŏ厲߂
+    float axis[3] = { 0.299f, 0.587f, 0.114f };
+    for (int n = 0; n < 4; ++n)
+    {
+      const float x(cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2]);
+      const float y(cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2]);
+      const float z(cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]);
+      const float l(std::max(fabs(x), std::max(fabs(y), fabs(z))));
+      if (l <= 0.0f) break;
+      axis[0] = x / l;
+      axis[1] = y / l;
+      axis[2] = z / l;
+    }
+
+    // 厲̓e͈̔͂߂
+    float tmin(FLT_MAX), tmax(-FLT_MAX);
+    for (int i = 0; i < 16; ++i)
+    {
+      const float t((px[0][i] - mean[0]) * axis[0] + (px[1][i] - mean[1]) * axis[1] + (px[2][i] - mean[2]) * axis[2]);
+      tmin = std::min(tmin, t);
+      tmax = std::max(tmax, t);
+    }
+
+    // [Ɋ񂹂đ\Fɂ
+    const float a2(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    const float inset((tmax - tmin) / 16.0f);
+    const float s0(a2 > 0.0f ? (tmax - inset) / a2 : 0.0f);
+    const float s1(a2 > 0.0f ? (tmin + inset) / a2 : 0.0f);
+    GLushort c0(packRGB565(mean[0] + axis[0] * s0, mean[1] + axis[1] * s0, mean[2] + axis[2] * s0));
+    GLushort c1(packRGB565(mean[0] + axis[0] * s1, mean[1] + axis[1] * s1, mean[2] + axis[2] * s1));
+
+    // 4 F[hɂ邽߂ c0 > c1 ɂ
+    if (c0 < c1) std::swap(c0, c1);
+
+    GLuint indices(0);
+    if (c0 != c1)
+    {
+      // CfbNX߂
+      float error(selectBC1(px, c0, c1, indices));
+
+      // ߂CfbNX\Fŏ@ŋߒ
+      static const float weight[] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+      float aa(0.0f), ab(0.0f), bb(0.0f), ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+      for (int i = 0; i < 16; ++i)
+      {
+        const float w(weight[indices >> (i * 2) & 3]), v(1.0f - w);
+        aa += w * w;
+        ab += w * v;
+        bb += v * v;
+        for (int k = 0; k < 3; ++k)
+        {
+          ax[k] += w * px[k][i];
+          bx[k] += v * px[k][i];
+        }
+      }
+      const float det(aa * bb - ab * ab);
+      if (fabs(det) > 1.0e-6f)
+      {
+        float e0[3], e1[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          e0[k] = (bb * ax[k] - ab * bx[k]) / det;
+          e1[k] = (aa * bx[k] - ab * ax[k]) / det;
+        }
+        GLushort d0(packRGB565(e0[0], e0[1], e0[2]));
+        GLushort d1(packRGB565(e1[0], e1[1], e1[2]));
+        if (d0 < d1) std::swap(d0, d1);
+
+        // 덷Ȃ΍̗p
+        if (d0 != d1)
+        {
+          GLuint refined;
+          if (selectBC1(px, d0, d1, refined) < error)
+          {
+            c0 = d0;
+            c1 = d1;
+            indices = refined;
+          }
+        }
+      }
+    }
+
+    // ubNɏ
+    block[0] = static_cast<GLubyte>(c0 & 0xff);
+    block[1] = static_cast<GLubyte>(c0 >> 8);
+    block[2] = static_cast<GLubyte>(c1 & 0xff);
+    block[3] = static_cast<GLubyte>(c1 >> 8);
+    block[4] = static_cast<GLubyte>(indices & 0xff);
+    block[5] = static_cast<GLubyte>(indices >> 8 & 0xff);
+    block[6] = static_cast<GLubyte>(indices >> 16 & 0xff);
+    block[7] = static_cast<GLubyte>(indices >> 24);
+  }
+
+  // ubN̍s͈̔͂k
+  static void compressRowsBC1(const GLubyte *image, GLsizei width, GLsizei height, int channels, int red,
+    GLsizei first, GLsizei last, GLubyte *data)
+  {
+    // ̃ubN
+    const GLsizei bw((width + 3) / 4);
+
+    // ubN̉f
+    float px[3][16];
+
+    for (GLsizei by = first; by < last; ++by)
+    {
+      for (GLsizei bx = 0; bx < bw; ++bx)
+      {
+        // ubN̉fo (摜̊O͒[̉fŖ߂)
+        for (int i = 0; i < 16; ++i)
+        {
+          const GLsizei x(std::min(bx * 4 + (i & 3), width - 1));
+          const GLsizei y(std::min(by * 4 + (i >> 2), height - 1));
+          const GLubyte *const p(image + (static_cast<size_t>(y) * width + x) * channels);
+          px[0][i] = p[red];
+          px[1][i] = p[1];
+          px[2][i] = p[2 - red];
+        }
+
+        // ubNk
+        compressBlockBC1(px, data + (static_cast<size_t>(by) * bw + bx) * 8);
+      }
+    }
+  }
+}
+// \endcond
+
+/*!
+** \brief 摜 BC1 (DXT1) `Ɉk.
+**
+**   \param image k摜f[^.
+**   \param width 摜̕.
+**   \param height 摜̍.
+**   \param format 摜f[^̏. GL_RGB, GL_BGR, GL_RGBA, GL_BGRA (At@͖).
+**   \param data kf[^̊i[ (nullptr ȂKvȃoCg߂邾).
+**   \param threads gpXbh (0 Ȃn[hEFÃXbh).
+**   \return kf[^̃oCg.
+*/
+size_t gg::ggCompressBC1(const GLubyte *image, GLsizei width, GLsizei height, GLenum format,
+  GLubyte *data, unsigned int threads)
+{
+  // ubN
+  const GLsizei bw((width + 3) / 4), bh((height + 3) / 4);
+
+  // kf[^̃oCg
+  const size_t size(static_cast<size_t>(bw) * bh * 8);
+
+  // i[悪Ȃ΃oCgԂ
+  if (data == nullptr || image == nullptr || size == 0) return size;
+
+  // 1 f̃oCgƐԐ̈ʒu
+  const int channels(format == GL_RGBA || format == GL_BGRA ? 4 : 3);
+  const int red(format == GL_BGR || format == GL_BGRA ? 2 : 0);
+
+  // Xbh̓ubN̍s𒴂Ȃ悤ɂ
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  if (threads == 0) threads = 1;
+  if (threads > static_cast<unsigned int>(bh)) threads = bh;
+
+  // ubN̍s𕪂ĕɈk
+  std::vector<std::thread> worker;
+  for (unsigned int t = 1; t < threads; ++t)
+  {
+    worker.push_back(std::thread(compressRowsBC1, image, width, height, channels, red,
+      GLsizei(bh * t / threads), GLsizei(bh * (t + 1) / threads), data));
+  }
+  compressRowsBC1(image, width, height, channels, red, 0, GLsizei(bh / threads), data);
+  for (std::vector<std::thread>::iterator it = worker.begin(); it != worker.end(); ++it) it->join();
+
+  return size;
+}
+
+/*!
+** \brief Px_̔z𔼐x_ɕϊ.
+**
+**   \param src ϊPx_̔z.
+**   \param count ϊvf.
+**   \param dst ϊx_̊i[.
+*/
+void gg::ggFloatToHalf(const GLfloat *src, size_t count, GLhalf *dst)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // Px_̃rbg
+    GLuint x;
+    memcpy(&x, src + i, sizeof x);
+
+    // ƐΒl
+    const GLuint sign(x >> 16 & 0x8000);
+    const GLuint abs(x & 0x7fffffff);
+
+    if (abs >= 0x7f800000)
+    {
+      // Ɣ
+      dst[i] = static_cast<GLhalf>(sign | 0x7c00 | (abs > 0x7f800000 ? 0x0200 : 0));
+    }
+    else if (abs >= 0x47800000)
+    {
+      // xŕ\Ȃ傫Ȃ疳ɂ
+      dst[i] = static_cast<GLhalf>(sign | 0x7c00);
+    }
+    else if (abs >= 0x38800000)
+    {
+      // K͎w̃oCAXtւĉ̉ 13 bit ŋߐڋɊۂ߂
+      GLuint h((abs - 0x38000000) >> 13);
+      const GLuint rest(abs & 0x1fff);
+      if (rest > 0x1000 || (rest == 0x1000 && (h & 1))) ++h;
+      dst[i] = static_cast<GLhalf>(sign | h);
+    }
+    else if (abs >= 0x33000000)
+    {
+      // xł͔񐳋KɂȂl͉炵čŋߐڋɊۂ߂
+      const GLuint shift(126 - (abs >> 23));
+      const GLuint mantissa((abs & 0x007fffff) | 0x00800000);
+      GLuint h(mantissa >> shift);
+      const GLuint rest(mantissa & ((1u << shift) - 1)), half(1u << (shift - 1));
+      if (rest > half || (rest == half && (h & 1))) ++h;
+      dst[i] = static_cast<GLhalf>(sign | h);
+    }
+    else
+    {
+      // l 0 ɂ
+      dst[i] = static_cast<GLhalf>(sign);
+    }
+  }
+}
+
+// \cond STRUCT
+namespace gg
+{
+  // ʑ̎ʑ@̕t̑gPʃxNgɖ߂ (ggQuantizedDecoder ƓvZ)
+  static void decodeOctahedron(GLint x, GLint y, GLfloat range, GLfloat *n)
+  {
+    const GLfloat u(std::max(GLfloat(x) / range, -1.0f));
+    const GLfloat v(std::max(GLfloat(y) / range, -1.0f));
+    n[0] = u;
+    n[1] = v;
+    n[2] = 1.0f - fabs(u) - fabs(v);
+    if (n[2] < 0.0f)
+    {
+      n[0] = (1.0f - fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+      n[1] = (1.0f - fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+    }
+    const GLfloat l(sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]));
+    n[0] /= l;
+    n[1] /= l;
+    n[2] /= l;
+  }
+
+  // PʃxNg𔪖ʑ̎ʑČ덷ŏɂȂ镄t̑gɂ
+  static void encodeOctahedron(const GLfloat *n, GLfloat range, GLint &x, GLint &y)
+  {
+    // ʑ̂Ɏˉeĉ͐܂Ԃ
+    const GLfloat l(fabs(n[0]) + fabs(n[1]) + fabs(n[2]));
+    GLfloat u(l > 0.0f ? n[0] / l : 0.0f), v(l > 0.0f ? n[1] / l : 0.0f);
+    if (n[2] < 0.0f)
+    {
+      const GLfloat t(u);
+      u = (1.0f - fabs(v)) * (t >= 0.0f ? 1.0f : -1.0f);
+      v = (1.0f - fabs(t)) * (v >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    // ؂̂ĂƐ؂グ̑gݍ킹̖̂@Ƃ̓ςő̂̂I
+    const GLint x0(static_cast<GLint>(floor(u * range))), y0(static_cast<GLint>(floor(v * range)));
+    const GLint limit(static_cast<GLint>(range));
+    GLfloat best(-2.0f);
+    for (int i = 0; i < 4; ++i)
+    {
+      const GLint cx(std::min(std::max(x0 + (i & 1), -limit), limit));
+      const GLint cy(std::min(std::max(y0 + (i >> 1), -limit), limit));
+      GLfloat d[3];
+      decodeOctahedron(cx, cy, range, d);
+      const GLfloat dot(d[0] * n[0] + d[1] * n[1] + d[2] * n[2]);
+      if (dot > best)
+      {
+        best = dot;
+        x = cx;
+        y = cy;
+      }
+    }
+  }
+}
+// \endcond
+
+/*!
+** \brief _̈ʒuƖ@ʎqċl߂_f[^.
+**
+**   \param nv _.
+**   \param pos _̈ʒu.
+**   \param norm _̖@.
+**   \param type @̐̃f[^^ (GL_SHORT Ȃ 1 _ 12 oCg, GL_BYTE Ȃ 8 oCg).
+**   \param data ʎq_f[^̊i[ (nullptr ȂKvȃoCg߂邾).
+**   \param scale ʒu̕Ɏg AABB ̑傫̊i[ (3 vf).
+**   \param offset ʒu̕Ɏg AABB ̍ŏl̊i[ (3 vf).
+**   \return ʎq_f[^̃oCg.
+*/
+size_t gg::ggQuantizeVertices(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3], GLenum type,
+  GLubyte *data, GLfloat *scale, GLfloat *offset)
+{
+  // 1 _̃oCgƖ@̒l͈̔
+  const size_t stride(type == GL_BYTE ? 8 : 12);
+  const GLfloat range(type == GL_BYTE ? 127.0f : 32767.0f);
+  if (data == nullptr) return stride * nv;
+
+  // _ʒu AABB
+  GLfloat bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+  for (GLuint v = 0; v < nv; ++v)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      bmin[k] = std::min(bmin[k], pos[v][k]);
+      bmax[k] = std::max(bmax[k], pos[v][k]);
+    }
+  }
+  for (int k = 0; k < 3; ++k)
+  {
+    if (nv == 0) bmin[k] = bmax[k] = 0.0f;
+    offset[k] = bmin[k];
+    scale[k] = bmax[k] - bmin[k];
+  }
+
+  for (GLuint v = 0; v < nv; ++v)
+  {
+    GLubyte *const p(data + stride * v);
+
+    // ʒu AABB ɑ΂ 16 rbg̕ȂKɂ
+    GLushort q[4] = { 0, 0, 0, 0 };
+    for (int k = 0; k < 3; ++k)
+    {
+      const GLfloat t(scale[k] > 0.0f ? (pos[v][k] - offset[k]) / scale[k] : 0.0f);
+      q[k] = static_cast<GLushort>(std::min(std::max(t, 0.0f), 1.0f) * 65535.0f + 0.5f);
+    }
+    memcpy(p, q, sizeof (GLushort[3]));
+
+    // @͔ʑ̎ʑĕt̑gɂ
+    GLint x, y;
+    encodeOctahedron(norm[v], range, x, y);
+    if (type == GL_BYTE)
+    {
+      const GLbyte b[2] = { static_cast<GLbyte>(x), static_cast<GLbyte>(y) };
+      memcpy(p + 6, b, sizeof b);
+    }
+    else
+    {
+      const GLshort s[2] = { static_cast<GLshort>(x), static_cast<GLshort>(y) };
+      memcpy(p + 6, q + 3, sizeof (GLushort));
+      memcpy(p + 8, s, sizeof s);
+    }
+  }
+
+  return stride * nv;
+}
+
+/*!
+** \brief ʎq_f[^𕜍 GLSL ̊֐̃\[XvO.
+*/
+const char *const gg::ggQuantizedDecoder =
+  "uniform vec3 qscale;\n"
+  "uniform vec3 qoffset;\n"
+  "uniform float qrange;\n"
+  "vec4 ggDecodePosition(const in vec3 q)\n"
+  "{\n"
+  "  return vec4(qoffset + qscale * q, 1.0);\n"
+  "}\n"
+  "vec3 ggDecodeNormal(const in vec2 e)\n"
+  "{\n"
+  "  vec2 f = max(e / qrange, -1.0);\n"
+  "  vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));\n"
+  "  if (n.z < 0.0) n.xy = (1.0 - abs(f.yx)) * vec2(f.x >= 0.0 ? 1.0 : -1.0, f.y >= 0.0 ? 1.0 : -1.0);\n"
+  "  return normalize(n);\n"
+  "}\n";
+
+/*
+** Ƀ}bvt@CFRXgN^
+*/
+gg::GgMappedFile::GgMappedFile(const char *name)
+  : address(nullptr), length(0)
+#if defined(_WIN32)
+  , file(INVALID_HANDLE_VALUE), mapping(nullptr)
+#endif
+{
+  if (name) open(name);
+}
+
+/*
+** Ƀ}bvt@CFt@C}bv
+*/
+bool gg::GgMappedFile::open(const char *name)
+{
+  // }bvς݂Ȃ
+  close();
+
+#if defined(_WIN32)
+  // t@CJ
+  file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+
+  // t@C̃TCY𒲂ׂ
+  LARGE_INTEGER filesize;
+  if (!GetFileSizeEx(file, &filesize) || filesize.QuadPart == 0)
+  {
+    close();
+    return false;
+  }
+
+  // t@C}bv
+  mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr)
+  {
+    close();
+    return false;
+  }
+  address = static_cast<const GLubyte *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (address == nullptr)
+  {
+    close();
+    return false;
+  }
+  length = static_cast<size_t>(filesize.QuadPart);
+#else
+  // t@CJ
+  const int fd(::open(name, O_RDONLY));
+  if (fd < 0) return false;
+
+  // t@C̃TCY𒲂ׂ
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  // t@C}bv (}bv̓t@CĂ悢)
+  void *const p(mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0));
+  ::close(fd);
+  if (p == MAP_FAILED) return false;
+  address = static_cast<const GLubyte *>(p);
+  length = static_cast<size_t>(st.st_size);
+#endif
+
+  return true;
+}
+
+/*
+** Ƀ}bvt@CFt@C̃}bv
+*/
+void gg::GgMappedFile::close()
+{
+#if defined(_WIN32)
+  if (address) UnmapViewOfFile(address);
+  if (mapping) CloseHandle(mapping);
+  if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+  file = INVALID_HANDLE_VALUE;
+  mapping = nullptr;
+#else
+  if (address) munmap(const_cast<GLubyte *>(address), length);
+#endif
+  address = nullptr;
+  length = 0;
+}
+
+/*!
+** \brief ̉摜̃}bvoht@Cɕۑ.
+**
+**   \param name ۑt@C.
+**   \param count ۑ摜̐.
+**   \param entry ۑ摜̖ڎ̍ڂ̔z (offset ͖).
+**   \param data ۑ摜f[^̃|C^̔z.
+**   \param alignment 摜f[^̐擪̃oCgE.
+**   \return ۑɐ true, s false.
+*/
+bool gg::ggSaveBundle(const char *name, GLuint count, const GgBundleEntry *entry,
+  const GLvoid *const *data, GLuint alignment)
+{
+  // t@CJ
+  std::ofstream file(name, std::ios::binary);
+
+  // t@CJȂ߂
+  if (!file)
+  {
+    std::cerr << "Error: Can't open file: " << name << std::endl;
+    return false;
+  }
+
+  // oCgE 16 ȏɂ
+  if (alignment < 16) alignment = 16;
+
+  // wb_
+  const GgBundleHeader header = { { 'G', 'G', 'M', 'B' }, 1, count, alignment };
+
+  // ڎ
+  std::vector<GgBundleEntry> toc(entry, entry + count);
+  GLuint64 offset(sizeof header + sizeof (GgBundleEntry) * count);
+  for (GLuint i = 0; i < count; ++i)
+  {
+    offset = (offset + alignment - 1) / alignment * alignment;
+    toc[i].offset = offset;
+    offset += toc[i].size;
+  }
+
+  // wb_Ɩڎ
+  file.write(reinterpret_cast<const char *>(&header), sizeof header);
+  if (count > 0) file.write(reinterpret_cast<const char *>(&toc[0]), sizeof (GgBundleEntry) * count);
+
+  // 摜f[^oCgE낦ď
+  GLuint64 position(sizeof header + sizeof (GgBundleEntry) * count);
+  for (GLuint i = 0; i < count && file; ++i)
+  {
+    static const char padding[16] = { 0 };
+    while (position < toc[i].offset)
+    {
+      const GLuint64 n(std::min(toc[i].offset - position, static_cast<GLuint64>(sizeof padding)));
+      file.write(padding, static_cast<std::streamsize>(n));
+      position += n;
+    }
+    file.write(static_cast<const char *>(data[i]), static_cast<std::streamsize>(toc[i].size));
+    position += toc[i].size;
+  }
+
+  // ݃`FbN
+  if (file.bad())
+  {
+    std::cerr << "Error: Can't write bundle data: " << name << std::endl;
+    file.close();
+    return false;
+  }
+
+  // t@C
+  file.close();
+
+  return true;
+}
+
+/*
+** }bvohFRXgN^
+*/
+gg::GgBundle::GgBundle(const char *name)
+  : file(name), header(nullptr), entries(nullptr)
+{
+  // }bvłȂ߂
+  if (file.data() == nullptr) return;
+
+  // wb_𒲂ׂ
+  const GgBundleHeader *const h(reinterpret_cast<const GgBundleHeader *>(file.data()));
+  if (file.size() < sizeof (GgBundleHeader)
+    || h->magic[0] != 'G' || h->magic[1] != 'G' || h->magic[2] != 'M' || h->magic[3] != 'B'
+    || h->version != 1
+    || file.size() < sizeof (GgBundleHeader) + sizeof (GgBundleEntry) * h->count)
+  {
+    std::cerr << "Error: Invalid bundle file: " << name << std::endl;
+    file.close();
+    return;
+  }
+
+  // ڎ𒲂ׂ
+  const GgBundleEntry *const e(reinterpret_cast<const GgBundleEntry *>(h + 1));
+  for (GLuint i = 0; i < h->count; ++i)
+  {
+    if (e[i].offset > file.size() || e[i].size > file.size() - e[i].offset)
+    {
+      std::cerr << "Error: Broken bundle entry: " << name << ": " << i << std::endl;
+      file.close();
+      return;
+    }
+  }
+
+  header = h;
+  entries = e;
+}
+
+/*
+** }bvohF摜 GL_TEXTURE_2D ̃eNX`ɓ]
+*/
+GLuint gg::GgBundle::loadTexture(GLuint i, GLuint tex) const
+{
+  // 摜ȂΖ߂
+  if (i >= count()) return 0;
+
+  // eNX`IuWFNg
+  if (tex == 0) glGenTextures(1, &tex);
+  ggBindTexture(GL_TEXTURE_2D, tex);
+
+  // 摜f[^͋l߂Ċi[Ă
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  // eNX`蓖Ă
+  const GgBundleEntry &e(entries[i]);
+  if (e.format == 0)
+  {
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, e.internal, e.width, e.height, 0,
+      static_cast<GLsizei>(e.size), data(i));
+  }
+  else
+  {
+    glTexImage2D(GL_TEXTURE_2D, 0, e.internal, e.width, e.height, 0, e.format, e.type, data(i));
+  }
+
+  // oCjAi~bv}bvȂjCEFŃNv
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, e.border);
+
+  // eNX`IuWFNgԂ
+  return tex;
+}
+
+/*
+** }bvohFA摜 GL_TEXTURE_2D_ARRAY ̃eNX`̊eCɓ]
+*/
+GLuint gg::GgBundle::loadArray(GLuint first, GLuint layers, GLuint tex) const
+{
+  // 摜ȂΖ߂
+  if (first >= count()) return 0;
+
+  // C
+  if (layers == 0 || first + layers > count()) layers = count() - first;
+
+  // ׂẲ摜̑傫ƏĂ邩ׂ
+  const GgBundleEntry &e(entries[first]);
+  bool contiguous(true);
+  for (GLuint i = first + 1; i < first + layers; ++i)
+  {
+    const GgBundleEntry &f(entries[i]);
+    if (f.width != e.width || f.height != e.height || f.internal != e.internal
+      || f.format != e.format || f.type != e.type || f.size != e.size)
+    {
+      std::cerr << "Error: Bundle layers are not uniform: " << f.name << std::endl;
+      return 0;
+    }
+
+    // 摜f[^t@CŌԂȂł邩ׂ
+    if (f.offset != entries[i - 1].offset + entries[i - 1].size) contiguous = false;
+  }
+
+  // eNX`IuWFNg
+  if (tex == 0) glGenTextures(1, &tex);
+  ggBindTexture(GL_TEXTURE_2D_ARRAY, tex);
+
+  // 摜f[^͋l߂Ċi[Ă
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (contiguous)
+  {
+    // 摜f[^AĂΈxɓ]
+    if (e.format == 0)
+    {
+      glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, 0, e.internal, e.width, e.height, layers, 0,
+        static_cast<GLsizei>(e.size * layers), data(first));
+    }
+    else
+    {
+      glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, e.internal, e.width, e.height, layers, 0,
+        e.format, e.type, data(first));
+    }
+  }
+  else
+  {
+    // 摜f[^AĂȂ΃eNX`mۂĂ烌CƂɓ]
+    if (e.format == 0)
+    {
+      glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, 0, e.internal, e.width, e.height, layers, 0,
+        static_cast<GLsizei>(e.size * layers), nullptr);
+      for (GLuint i = 0; i < layers; ++i)
+      {
+        glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, e.width, e.height, 1,
+          e.internal, static_cast<GLsizei>(e.size), data(first + i));
+      }
+    }
+    else
+    {
+      glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, e.internal, e.width, e.height, layers, 0,
+        e.format, e.type, nullptr);
+      for (GLuint i = 0; i < layers; ++i)
+      {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, e.width, e.height, 1,
+          e.format, e.type, data(first + i));
+      }
+    }
+  }
+
+  // oCjAi~bv}bvȂjCEFŃNv
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+  glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, e.border);
+
+  // eNX`IuWFNgԂ
+  return tex;
+}
+
+// \cond STRUCT
+/*
+** OBJ t@C̓ǂݍ݂Ɏgf[^^
+**
+**     Vine Linux 6.1  gcc 4.4.5 , [Jɒ`
+**     NXE\̂ template ŎgƃG[ɂȂ.
+*/
+namespace gg
+{
+  // F
+  struct rgb
+  {
+    float r, g, b;
+  };
+
+  // }eA
+  struct mat
+  {
+    rgb amb;      // ambient
+    rgb diff;     // diffuse
+    rgb spec;     // specular
+    float shi;    // shininess
+    float dis;    // dissolve
+  };
+
+  // xNg
+  struct vec
+  {
+    float x, y, z;
+  };
+
+  // ʃf[^
+  struct idx
+  {
+    GLuint p[3];  // _Wԍ
+    GLuint n[3];  // _@ԍ
+    GLuint t[3];  // eNX`Wԍ
+    bool smooth;  // X[YVF[fBO̗L
+  };
+
+  // ʃO[v
+  struct grp
+  {
+    GLuint b;     // ʃO[v̊Jnԍ
+    GLuint c;     // ʃO[v̒_
+    const mat *m; // ʃO[ṽ}eA
+    grp(GLuint begin, GLuint count, const mat &material)
+      : b(begin), c(count), m(&material) {}
+  };
+
+  // OBJ / MTL t@C̎
+  //   ̃eLXgs󔒂ŋ؂g[Nɕ.
+  //   sƂ̐̕Xg[g킸Ƀ|C^œǂݐi߂.
+  class scanner
+  {
+    // ǂݏoʒu
+    const char *p;
+
+    // eLXg̏I[
+    const char *const end;
+
+    // s̒̋󔒕Ȃ true (s͊܂܂Ȃ)
+    static bool blank(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // 10 ׂ̂ (PxŐmɕ\͈)
+    static float power(int e)
+    {
+      static const float table[] =
+      {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+      };
+      return table[e];
+    }
+
+  public:
+
+    // RXgN^
+    scanner(const char *begin, const char *end)
+      : p(begin), end(end) {}
+
+    // eLXg̏I[ɒBĂ true
+    bool eof() const
+    {
+      return p >= end;
+    }
+
+    // ̍s̐擪ɐi
+    void next()
+    {
+      const void *const q(p < end ? memchr(p, '\n', end - p) : nullptr);
+      p = q ? static_cast<const char *>(q) + 1 : end;
+    }
+
+    // s̒̋󔒂ǂݔ΂
+    void skip()
+    {
+      while (p < end && blank(*p)) ++p;
+    }
+
+    // g[NoĂ̒Ԃ (sȂ 0)
+    size_t token(const char *&t)
+    {
+      skip();
+      t = p;
+      while (p < end && *p != '\n' && !blank(*p)) ++p;
+      return p - t;
+    }
+
+    // og[N s ƈv true
+    static bool match(const char *t, size_t n, const char *s)
+    {
+      return strlen(s) == n && memcmp(t, s, n) == 0;
+    }
+
+    // s̎coĂ̒Ԃ (擪̋󔒂Ɩ \r )
+    size_t rest(const char *&t)
+    {
+      skip();
+      t = p;
+      while (p < end && *p != '\n') ++p;
+      const char *e(p);
+      if (e > t && e[-1] == '\r') --e;
+      return e - t;
+    }
+
+    // o (ǂݎȂ 0)
+    float real()
+    {
+      skip();
+      const char *const t(p);
+
+      // 
+      bool negative(false);
+      if (p < end && (*p == '+' || *p == '-')) negative = *p++ == '-';
+
+      //  10 i̐ƂĎo
+      unsigned long long m(0);
+      int digits(0), e(0);
+      bool valid(false);
+      for (; p < end && *p >= '0' && *p <= '9'; ++p, valid = true)
+      {
+        if (digits < 19)
+        {
+          m = m * 10 + (*p - '0');
+          if (m > 0) ++digits;
+        }
+        else ++e;
+      }
+      if (p < end && *p == '.')
+      {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p, valid = true)
+        {
+          if (digits < 19)
+          {
+            m = m * 10 + (*p - '0');
+            if (m > 0) ++digits;
+            --e;
+          }
+        }
+      }
+
+      // ȂΓǂݎȂ
+      if (!valid) return 0.0f;
+
+      // w
+      bool exact(digits < 19);
+      if (p < end && (*p == 'e' || *p == 'E'))
+      {
+        const char *q(p + 1);
+        bool en(false);
+        if (q < end && (*q == '+' || *q == '-')) en = *q++ == '-';
+        if (q < end && *q >= '0' && *q <= '9')
+        {
+          int x(0);
+          for (; q < end && *q >= '0' && *q <= '9'; ++q)
+          {
+            if (x < 10000) x = x * 10 + (*q - '0');
+          }
+          e += en ? -x : x;
+          p = q;
+        }
+      }
+
+      // ̖ 0 wɈڂ
+      while (m != 0 && m % 10 == 0)
+      {
+        m /= 10;
+        ++e;
+      }
+
+      //  10 ׂ̂悪ƂɒPxŐmɕ\Ȃ 1 ̉ZŐۂ߂
+      if (exact && m <= (1ull << 24) && e >= -10 && e <= 10)
+      {
+        const float v(e < 0 ? float(m) / power(-e) : float(m) * power(e));
+        return negative ? -v : v;
+      }
+
+      // ȊO͕WCuŕϊ
+      char buffer[64];
+      const size_t n(p - t);
+      float v;
+      if (n < sizeof buffer)
+      {
+        memcpy(buffer, t, n);
+        buffer[n] = '\0';
+        v = strtof(buffer, nullptr);
+      }
+      else
+      {
+        v = strtof(std::string(t, p).c_str(), nullptr);
+      }
+
+      // ͈͊O̒l std::istream Ɠőlɂ
+      return std::min(std::max(v, -FLT_MAX), FLT_MAX);
+    }
+
+    // g[N̐o (atoi() ƓǂݎȂ 0)
+    static int integer(const char *&t, const char *e)
+    {
+      bool negative(false);
+      if (t < e && (*t == '+' || *t == '-')) negative = *t++ == '-';
+      int v(0);
+      for (; t < e && *t >= '0' && *t <= '9'; ++t) v = v * 10 + (*t - '0');
+      return negative ? -v : v;
+    }
+
+    // ̔ԍ (ΎQ) ܂łɒ`ꂽvf̐ count  1 n܂ԍɒ
+    static GLuint index(int i, GLuint count)
+    {
+      return static_cast<GLuint>(i < 0 ? static_cast<int>(count) + 1 + i : i);
+    }
+
+    // ʂ̒_ "ʒu/eNX`W/@" ̔ԍo
+    static void vertex(const char *t, size_t n, GLuint &p, GLuint &tc, GLuint &nm,
+      GLuint np, GLuint nt, GLuint nn)
+    {
+      const char *const e(t + n);
+
+      // ڂ̍ŏ̗vf͒_Wԍ
+      p = index(integer(t, e), np);
+      tc = nm = 0;
+
+      // c̍ڂo
+      t = std::find(t, e, '/');
+      if (t != e)
+      {
+        // ڂ̍ڂ̓eNX`W
+        tc = index(integer(++t, e), nt);
+
+        // Oڂ̍ڂ͖@ԍ
+        t = std::find(t, e, '/');
+        if (t != e) nm = index(integer(++t, e), nn);
+      }
+    }
+  };
+
+  // ʂ̏Ԃς閽
+  struct event
+  {
+    enum { smooth, usemtl, mtllib } op; // ߂̎
+    GLuint face;                        // ̖߂Oɂʂ̐ (`N)
+    const char *t;                      // ̐擪
+    size_t n;                           // ̒
+  };
+
+  // OBJ t@Cs̋؂ŕ
+  struct chunk
+  {
+    const char *begin, *end;            // eLXg͈̔
+    GLuint nv, nt, nn, nf;              // _ʒu, eNX`W, @, ʂ̐
+    GLuint bv, bt, bn, bf;              // ̑Ŝ̒ł̐擪̔ԍ (̗ݐϘa)
+    bool smooth;                        // 擪̖ʂ̃X[YVF[fBȌ
+    std::vector<event> events;          // ʂ̏Ԃς閽
+    float box[6];                       // _ʒu̍ŏlEől (AABB)
+  };
+
+  // OBJ t@C̓ǂݍݗp̈ꎞL̈
+  //   vf𐔂ĂKvȑ傫܂Ƃ߂ĊmۂĐ؂蕪, fXgN^ňxɉ.
+  //   ؂蕪̈͏Ȃ̂, ׂĂ̗vfɏłg.
+  class arena
+  {
+    // mۂubN
+    std::vector<char *> blocks;
+
+    // Ō̃ubN̋󂢂ĂʒuƏI
+    char *next, *last;
+
+    // ؂蕪̈̋E
+    static const size_t alignment = 64;
+
+    // Rs[͋֎~
+    arena(const arena &o);
+    arena &operator=(const arena &o);
+
+  public:
+
+    // RXgN^
+    arena()
+      : next(nullptr), last(nullptr) {}
+
+    // fXgN^
+    ~arena()
+    {
+      for (std::vector<char *>::const_iterator it = blocks.begin(); it != blocks.end(); ++it) delete[] *it;
+    }
+
+    // vf n ̗̈؂蕪̂ɎgoCg
+    template <typename T> static size_t size(size_t n)
+    {
+      return (n * sizeof (T) + alignment - 1) / alignment * alignment;
+    }
+
+    // ȍ~̐؂蕪Ɏg bytes oCg̃ubNmۂ
+    void reserve(size_t bytes)
+    {
+      char *const block(new char[bytes + alignment]);
+      blocks.push_back(block);
+      next = block + (alignment - reinterpret_cast<size_t>(block) % alignment) % alignment;
+      last = next + bytes;
+    }
+
+    // vf n ̗̈؂蕪 (󂫂Ȃ΂̂߂̃ubNmۂ)
+    template <typename T> T *allocate(size_t n)
+    {
+      const size_t bytes(size<T>(n));
+      if (static_cast<size_t>(last - next) < bytes) reserve(bytes);
+      T *const p(reinterpret_cast<T *>(next));
+      next += bytes;
+      return p;
+    }
+  };
+
+  // ꎞL̈ɓǂݍ OBJ t@C̗vf
+  struct elements
+  {
+    vec *pos, *tex, *norm;              // _ʒu, eNX`W, @
+    idx *face;                          // 
+    GLuint nv, nt, nn, nf;              // ̐
+  };
+
+  // OBJ t@C̓ǂݍ݂ɎgXbh (0 Ȃ玩)
+  static unsigned int objThreads(0);
+
+  // }eA̒`Ɛ؂ւ\邩ǂ
+  static bool objVerbose(false);
+
+  // `N̗vf𐔂Ėʂ̏Ԃς閽߂L^
+  static void countChunk(chunk &c, bool all)
+  {
+    c.nv = c.nt = c.nn = c.nf = 0;
+    c.events.clear();
+
+    // f[^sׂ
+    for (scanner str(c.begin, c.end); !str.eof(); str.next())
+    {
+      // ŏ̃g[N𖽗 (op) Ƃ݂Ȃ
+      const char *op;
+      const size_t opn(str.token(op));
+
+      if (scanner::match(op, opn, "v")) ++c.nv;
+      else if (scanner::match(op, opn, "f")) ++c.nf;
+      else if (!all) continue;
+      else if (scanner::match(op, opn, "vt")) ++c.nt;
+      else if (scanner::match(op, opn, "vn")) ++c.nn;
+      else
+      {
+        event e;
+        e.face = c.nf;
+        if (scanner::match(op, opn, "s"))
+        {
+          e.op = event::smooth;
+          e.n = str.token(e.t);
+        }
+        else if (scanner::match(op, opn, "usemtl"))
+        {
+          e.op = event::usemtl;
+          e.n = str.token(e.t);
+        }
+        else if (scanner::match(op, opn, "mtllib"))
+        {
+          e.op = event::mtllib;
+          e.n = str.rest(e.t);
+        }
+        else continue;
+        c.events.push_back(e);
+      }
+    }
+  }
+
+  // `N͂đŜ̒̊i[ɏ
+  static void parseChunk(chunk &c, bool all, vec *tpos, vec *ttex, vec *tnorm, idx *tface)
+  {
+    // i[
+    vec *pos(tpos + c.bv), *tex(ttex + c.bt), *norm(tnorm + c.bn);
+    idx *face(tface + c.bf);
+
+    // X[YVF[fBÕXCb`
+    bool smooth(c.smooth);
+
+    // Wl̍ŏlEől
+    float &xmin(c.box[0]), &xmax(c.box[1]), &ymin(c.box[2]), &ymax(c.box[3]), &zmin(c.box[4]), &zmax(c.box[5]);
+    xmax = ymax = zmax = -(xmin = ymin = zmin = FLT_MAX);
+
+    // f[^sǂݍ
+    for (scanner str(c.begin, c.end); !str.eof(); str.next())
+    {
+      // ŏ̃g[N𖽗 (op) Ƃ݂Ȃ
+      const char *op;
+      const size_t opn(str.token(op));
+
+      if (scanner::match(op, opn, "v"))
+      {
+        // _ʒu̓Xy[Xŋ؂Ă
+        vec &v(*pos++);
+        v.x = str.real();
+        v.y = str.real();
+        v.z = str.real();
+
+        // _ʒu̍ŏlƍől߂ (AABB)
+        xmin = std::min(xmin, v.x);
+        xmax = std::max(xmax, v.x);
+        ymin = std::min(ymin, v.y);
+        ymax = std::max(ymax, v.y);
+        zmin = std::min(zmin, v.z);
+        zmax = std::max(zmax, v.z);
+      }
+      else if (scanner::match(op, opn, "f"))
+      {
+        //  (Op`) f[^
+        idx &f(*face++);
+
+        // X[XVF[fBO
+        f.smooth = smooth;
+
+        // O_̂ꂼɂčڂoĒ_Wԍ, eNX`Wԍ, @ԍɕ
+        // (̔ԍ͂̍s܂łɒ`ꂽvf̐𑫂ĉ)
+        for (int i = 0; i < 3; ++i)
+        {
+          const char *t;
+          const size_t n(str.token(t));
+          scanner::vertex(t, n, f.p[i], f.t[i], f.n[i],
+            static_cast<GLuint>(pos - tpos), static_cast<GLuint>(tex - ttex), static_cast<GLuint>(norm - tnorm));
+        }
+      }
+      else if (!all) continue;
+      else if (scanner::match(op, opn, "vt"))
+      {
+        // eNX`W̓Xy[Xŋ؂Ă
+        vec &t(*tex++);
+        t.x = str.real();
+        t.y = str.real();
+        t.z = 0.0f;
+      }
+      else if (scanner::match(op, opn, "vn"))
+      {
+        // _@̓Xy[Xŋ؂Ă
+        vec &n(*norm++);
+        n.x = str.real();
+        n.y = str.real();
+        n.z = str.real();
+      }
+      else if (scanner::match(op, opn, "s"))
+      {
+        // '1' X[XVF[fBOL
+        const char *t;
+        const size_t n(str.token(t));
+        smooth = scanner::match(t, n, "1");
+      }
+    }
+  }
+
+  // OBJ t@C`Nɕĕɓǂݍ
+  //   all  false Ȃ璸_ʒuƖʂǂݍ
+  //   vf̊i[ temp vf𐔂ɈxɊmۂ
+  static void loadChunks(const char *text, size_t size, bool all, std::vector<chunk> &chunks,
+    arena &temp, elements &t, float *box)
+  {
+    //  (̂Ƃ 1 MB ̃t@C͕Ȃ)
+    size_t count(objThreads);
+    if (count == 0)
+    {
+      count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), size / 1048576 + 1);
+    }
+
+    // s̋؂ŕ
+    chunks.resize(count);
+    const char *const last(text + size);
+    for (size_t k = 0; k < count; ++k)
+    {
+      chunk &c(chunks[k]);
+      c.begin = k == 0 ? text : chunks[k - 1].end;
+      c.end = std::max(c.begin, text + size * (k + 1) / count);
+      if (c.end > c.begin && c.end < last && c.end[-1] != '\n')
+      {
+        c.end = std::find(c.end, last, '\n');
+        if (c.end < last) ++c.end;
+      }
+    }
+
+    // e`N̗vfɐ
+    std::vector<std::thread> worker;
+    for (size_t k = 1; k < count; ++k) worker.push_back(std::thread(countChunk, std::ref(chunks[k]), all));
+    countChunk(chunks[0], all);
+    for (std::vector<std::thread>::iterator it = worker.begin(); it != worker.end(); ++it) it->join();
+    worker.clear();
+
+    // vf̗ݐϘae`N̊i[, 擪̃X[YVF[fBȌԂp
+    GLuint nv(0), nt(0), nn(0), nf(0);
+    bool smooth(false);
+    for (std::vector<chunk>::iterator c = chunks.begin(); c != chunks.end(); ++c)
+    {
+      c->bv = nv;
+      c->bt = nt;
+      c->bn = nn;
+      c->bf = nf;
+      nv += c->nv;
+      nt += c->nt;
+      nn += c->nn;
+      nf += c->nf;
+      c->smooth = smooth;
+      for (std::vector<event>::const_iterator e = c->events.begin(); e != c->events.end(); ++e)
+      {
+        if (e->op == event::smooth) smooth = scanner::match(e->t, e->n, "1");
+      }
+    }
+
+    // i[xɊmۂĐ؂蕪
+    temp.reserve(arena::size<vec>(nv) + arena::size<vec>(nt) + arena::size<vec>(nn) + arena::size<idx>(nf));
+    t.pos = temp.allocate<vec>(t.nv = nv);
+    t.tex = temp.allocate<vec>(t.nt = nt);
+    t.norm = temp.allocate<vec>(t.nn = nn);
+    t.face = temp.allocate<idx>(t.nf = nf);
+
+    // e`Nɉ͂
+    for (size_t k = 1; k < count; ++k)
+    {
+      worker.push_back(std::thread(parseChunk, std::ref(chunks[k]), all, t.pos, t.tex, t.norm, t.face));
+    }
+    parseChunk(chunks[0], all, t.pos, t.tex, t.norm, t.face);
+    for (std::vector<std::thread>::iterator it = worker.begin(); it != worker.end(); ++it) it->join();
+
+    // _ʒu̍ŏlƍől܂Ƃ߂
+    box[0] = box[2] = box[4] = FLT_MAX;
+    box[1] = box[3] = box[5] = -FLT_MAX;
+    for (std::vector<chunk>::const_iterator c = chunks.begin(); c != chunks.end(); ++c)
+    {
+      for (int i = 0; i < 6; i += 2)
+      {
+        box[i] = std::min(box[i], c->box[i]);
+        box[i + 1] = std::max(box[i + 1], c->box[i + 1]);
+      }
+    }
+  }
+
+  // ʂ̖@߂ (first  last ̎O܂ł̖)
+  //   X[YVF[fBOʂ͐K fnorm , Ȃʂ͐K norm ̒_@ԍ̈ʒuɊi[
+  static void faceNormals(const vec *pos, const idx *face, size_t first, size_t last, bool all,
+    vec *fnorm, vec *norm)
+  {
+    for (size_t f = first; f < last; ++f)
+    {
+      // _Wԍ
+      const idx &it(face[f]);
+      const GLuint v0(it.p[0] - 1);
+      const GLuint v1(it.p[1] - 1);
+      const GLuint v2(it.p[2] - 1);
+
+      // v1 - v0, v2 - v0 ߂
+      const GLfloat dx1(pos[v1].x - pos[v0].x);
+      const GLfloat dy1(pos[v1].y - pos[v0].y);
+      const GLfloat dz1(pos[v1].z - pos[v0].z);
+      const GLfloat dx2(pos[v2].x - pos[v0].x);
+      const GLfloat dy2(pos[v2].y - pos[v0].y);
+      const GLfloat dz2(pos[v2].z - pos[v0].z);
+
+      // Oςɂʖ@߂
+      GLfloat nx(dy1 * dz2 - dz1 * dy2);
+      GLfloat ny(dz1 * dx2 - dx1 * dz2);
+      GLfloat nz(dx1 * dy2 - dy1 * dx2);
+
+      if (all || it.smooth)
+      {
+        // _@ɏW߂邽߂ɎcĂ
+        fnorm[f].x = nx;
+        fnorm[f].y = ny;
+        fnorm[f].z = nz;
+      }
+      else
+      {
+        // ʖ@𐳋K
+        const GLfloat a(sqrt(nx * nx + ny * ny + nz * nz));
+        if (a != 0.0f)
+        {
+          nx /= a;
+          ny /= a;
+          nz /= a;
+        }
+
+        // Kʖ@̂܂ 3 _̒_@ɂ
+        vec *const n(norm + it.n[0] - 1);
+        for (int i = 0; i < 3; ++i)
+        {
+          n[i].x = nx;
+          n[i].y = ny;
+          n[i].z = nz;
+        }
+      }
+    }
+  }
+
+  // _Lʂ̖@ʂ̏ɑ킹Ē_@߂ (first  last ̎O܂ł̒_)
+  static void gatherNormals(const GLuint *offset, const GLuint *adjacency, const vec *fnorm,
+    size_t first, size_t last, vec *norm)
+  {
+    for (size_t v = first; v < last; ++v)
+    {
+      vec n = { 0.0f, 0.0f, 0.0f };
+      for (GLuint j = offset[v]; j < offset[v + 1]; ++j)
+      {
+        const vec &f(fnorm[adjacency[j]]);
+        n.x += f.x;
+        n.y += f.y;
+        n.z += f.z;
+      }
+      norm[v] = n;
+    }
+  }
+
+  // ʂ̖@琳KĂȂ_@ɋ߂
+  //   _Lʂ̕\ (CSR) xĒ_Ƃɖʂ̖@ʂ̔ԍ̏ɏW߂̂,
+  //   r䂪v炸, Xbhɂ炸ʂ̖@ʂ̏ɒ_ɐώZꍇƓʂɂȂ.
+  //   all  false ȂX[YVF[fBOȂʂ̒_@ 3 _̌ɒǉ.
+  //   _@ temp Ɋmۂ t.norm  t.nn u, ʂ̒_@ԍ͂w悤ɏ.
+  static void computeNormals(arena &temp, elements &t, bool all)
+  {
+    const size_t nv(t.nv), nf(t.nf);
+
+    // Xbh (̂Ƃ 65536 ʂƂ 1 Xbh)
+    size_t count(objThreads);
+    if (count == 0)
+    {
+      count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), nf / 65536 + 1);
+    }
+
+    // X[YVF[fBOȂʂ̒_@̐
+    GLuint flat(0);
+    if (!all)
+    {
+      for (const idx *it = t.face; it != t.face + nf; ++it) if (!it->smooth) flat += 3;
+    }
+
+    // _@Ɩʂ̖@ƒ_Lʂ̕\̊i[xɊmۂĐ؂蕪
+    temp.reserve(arena::size<vec>(nv + flat) + arena::size<vec>(nf) + arena::size<GLuint>(nv + 1)
+      + (count == 1 ? 0 : arena::size<GLuint>(3 * nf) + arena::size<GLuint>(nv)));
+    t.norm = temp.allocate<vec>(t.nn = static_cast<GLuint>(nv + flat));
+    vec *const fnorm(temp.allocate<vec>(nf));
+    GLuint *const offset(temp.allocate<GLuint>(nv + 1));
+
+    // _Ƃ̖ʂ̐𐔂, X[YVF[fBOȂʂ̒_@̊i[߂
+    std::fill(offset, offset + nv + 1, 0);
+    flat = 0;
+    for (idx *it = t.face; it != t.face + nf; ++it)
+    {
+      if (all || it->smooth)
+      {
+        for (int i = 0; i < 3; ++i) ++offset[it->p[i]];
+        it->n[0] = it->p[0];
+        it->n[1] = it->p[1];
+        it->n[2] = it->p[2];
+      }
+      else
+      {
+        const GLuint v(static_cast<GLuint>(nv) + flat);
+        it->n[0] = v + 1;
+        it->n[1] = v + 2;
+        it->n[2] = v + 3;
+        flat += 3;
+      }
+    }
+
+    // ʂ̖@ɋ߂
+    std::vector<std::thread> worker;
+    for (size_t k = 1; k < count; ++k)
+    {
+      worker.push_back(std::thread(faceNormals, t.pos, t.face, nf * k / count, nf * (k + 1) / count, all, fnorm, t.norm));
+    }
+    faceNormals(t.pos, t.face, 0, nf / count, all, fnorm, t.norm);
+    for (std::vector<std::thread>::iterator it = worker.begin(); it != worker.end(); ++it) it->join();
+    worker.clear();
+
+    // ̃XbhŏƂ͕\炸ɖʂ̏ɒ_@ɐώZ
+    if (count == 1)
+    {
+      static const vec zero = { 0.0f, 0.0f, 0.0f };
+      std::fill(t.norm, t.norm + nv, zero);
+      for (size_t f = 0; f < nf; ++f)
+      {
+        const idx &it(t.face[f]);
+        if (!all && !it.smooth) continue;
+        for (int i = 0; i < 3; ++i)
+        {
+          vec &n(t.norm[it.p[i] - 1]);
+          n.x += fnorm[f].x;
+          n.y += fnorm[f].y;
+          n.z += fnorm[f].z;
+        }
+      }
+      return;
+    }
+
+    // ݐϘa璸_Ƃ̖ʂ̕\̊Jnʒu, ʂ̔ԍ̏ɕ\ɓo^
+    for (size_t v = 0; v < nv; ++v) offset[v + 1] += offset[v];
+    GLuint *const adjacency(temp.allocate<GLuint>(3 * nf));
+    GLuint *const next(temp.allocate<GLuint>(nv));
+    std::copy(offset, offset + nv, next);
+    for (size_t f = 0; f < nf; ++f)
+    {
+      const idx &it(t.face[f]);
+      if (all || it.smooth)
+      {
+        for (int i = 0; i < 3; ++i) adjacency[next[it.p[i] - 1]++] = static_cast<GLuint>(f);
+      }
+    }
+
+    // _@ɋ߂
+    for (size_t k = 1; k < count; ++k)
+    {
+      worker.push_back(std::thread(gatherNormals, offset, adjacency, fnorm, nv * k / count, nv * (k + 1) / count, t.norm));
+    }
+    gatherNormals(offset, adjacency, fnorm, 0, nv / count, t.norm);
+    for (std::vector<std::thread>::iterator it = worker.begin(); it != worker.end(); ++it) it->join();
+  }
+
+  // MTL t@Cǂݍ
+  static void loadMtl(const std::string &mtlpath, std::map<std::string, mat> &mtl, std::string &mtlname)
+  {
+    // MTL t@CɃ}bv
+    const GgMappedFile mtlfile(mtlpath.c_str());
+    if (!mtlfile.data())
+    {
+      // MTL t@CƂ
+      std::cerr << "Warning: Can't open MTL file: " << mtlpath << std::endl;
+      return;
+    }
+
+    // }bvt@C̎
+    const char *const mtltext(reinterpret_cast<const char *>(mtlfile.data()));
+
+    // }eAf[^sǂݍ
+    for (scanner mtlstr(mtltext, mtltext + mtlfile.size()); !mtlstr.eof(); mtlstr.next())
+    {
+      const char *mtlop;
+      const size_t mtlopn(mtlstr.token(mtlop));
+
+      if (scanner::match(mtlop, mtlopn, "newmtl"))
+      {
+        // VK}eAo͂
+        const char *t;
+        const size_t n(mtlstr.token(t));
+        if (n > 0) mtlname.assign(t, n);
+        if (objVerbose) std::cerr << "newmtl: " << mtlname << std::endl;
+      }
+      else if (scanner::match(mtlop, mtlopn, "Ka"))
+      {
+        // ̔ˌWo^
+        rgb &c(mtl[mtlname].amb);
+        c.r = mtlstr.real();
+        c.g = mtlstr.real();
+        c.b = mtlstr.real();
+      }
+      else if (scanner::match(mtlop, mtlopn, "Kd"))
+      {
+        // gUˌWo^
+        rgb &c(mtl[mtlname].diff);
+        c.r = mtlstr.real();
+        c.g = mtlstr.real();
+        c.b = mtlstr.real();
+      }
+      else if (scanner::match(mtlop, mtlopn, "Ks"))
+      {
+        // ʔˌWo^
+        rgb &c(mtl[mtlname].spec);
+        c.r = mtlstr.real();
+        c.g = mtlstr.real();
+        c.b = mtlstr.real();
+      }
+      else if (scanner::match(mtlop, mtlopn, "Ns"))
+      {
+        // PWo^
+        mtl[mtlname].shi = mtlstr.real();
+      }
+      else if (scanner::match(mtlop, mtlopn, "d"))
+      {
+        // sxo^
+        mtl[mtlname].dis = mtlstr.real();
+      }
+    }
+  }
+
+  // bVLbVgǂ
+  static bool objCache(true);
+
+  // ǂݍ񂾌`œK邩ǂ
+  static bool objOptimize(false);
+
+  // bVLbV̊ef[^̐擪̃oCgE
+  static const GLuint64 cacheAlignment(64);
+
+  // bVLbV̓e
+  enum
+  {
+    cacheIndexed = 1,                       // d̂Ȃ_ƃCfbNX
+    cacheOptimized = 2,                     // Op`ƒ_̏œKς
+    cacheLod = 4                            // ڍדx̒iKƂ̃CfbNXƌ덷
+  };
+
+  // bVLbṼwb_
+  struct cacheHeader
+  {
+    char magic[4];                          // ʎq "GGOC"
+    GLuint version;                         // ̃o[W
+    GLuint ng;                              // ʃO[v
+    GLuint nv;                              // _
+    GLuint nf;                              // Op` (CfbNX 0)
+    GLuint sources;                         // MTL t@C̐
+    GLuint flags;                           // e (cacheIndexed, cacheOptimized, cacheLod ̑gݍ킹)
+    GLuint levels;                          // ڍדx̒iK (iK 1)
+    GLint64 time;                           // OBJ t@C̍XV
+    GLint64 size;                           // OBJ t@C̃oCg
+    GLfloat box[6];                         // _ʒu̍ŏlƍől
+    GLuint64 offset[10];                    // group, amb, diff, spec, shi, pos, norm, face, error, MTL t@C̈ʒu
+  };
+
+  // bVLbVɋL^ MTL t@C̍ (̌ɃpX 8 oCgE܂ő)
+  struct cacheSource
+  {
+    GLint64 time;                           // XV (t@C -1)
+    GLint64 size;                           // oCg (t@C -1)
+    GLuint length;                          // pX̒
+    GLuint reserved;                        // \
+  };
+
+  // t@C̍XVƃoCg𒲂ׂ
+  static void fileStamp(const std::string &path, GLint64 &time, GLint64 &size)
+  {
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) == 0)
+    {
+      time = static_cast<GLint64>(st.st_mtime) * 1000000000;
+      size = static_cast<GLint64>(st.st_size);
+      return;
+    }
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+    {
+#  if defined(__APPLE__)
+      time = static_cast<GLint64>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#  else
+      time = static_cast<GLint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#  endif
+      size = static_cast<GLint64>(st.st_size);
+      return;
+    }
+#endif
+    time = size = -1;
+  }
+
+  // _ʒu𐳋KĊg嗦Ԃ
+  static GLfloat normalizeObj(GLuint nv, GLfloat (*pos)[3], const float *box)
+  {
+    const float &xmin(box[0]), &xmax(box[1]), &ymin(box[2]), &ymax(box[3]), &zmin(box[4]), &zmax(box[5]);
+
+    // ʒuƑ傫𐳋K邽߂̌W
+    const float sx(xmax - xmin);
+    const float sy(ymax - ymin);
+    const float sz(zmax - zmin);
+
+    GLfloat scale(sx);
+    if (sy > scale) scale = sy;
+    if (sz > scale) scale = sz;
+    scale = (scale != 0.0f) ? 2.0f / scale : 1.0f;
+
+    const GLfloat cx((xmax + xmin) * 0.5f);
+    const GLfloat cy((ymax + ymin) * 0.5f);
+    const GLfloat cz((zmax + zmin) * 0.5f);
+
+    for (GLuint v = 0; v < nv; ++v)
+    {
+      pos[v][0] = (pos[v][0] - cx) * scale;
+      pos[v][1] = (pos[v][1] - cy) * scale;
+      pos[v][2] = (pos[v][2] - cz) * scale;
+    }
+
+    return scale;
+  }
+
+  // bVLbVǂݍ
+  static bool loadCache(const std::string &path, const char *suffix, GLuint flags, std::vector<std::string> &sources,
+    GLuint &ng, GLuint (*&group)[2], GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+    GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3], GLuint &nl, GLfloat *&error,
+    GLuint &nf, GLuint (*&face)[3], float *box)
+  {
+    // OBJ t@C̍XVƃoCg
+    GLint64 time, size;
+    fileStamp(path, time, size);
+    if (time < 0) return false;
+
+    // bVLbVɃ}bv
+    const GgMappedFile file((path + suffix).c_str());
+    if (!file.data() || file.size() < sizeof (cacheHeader)) return false;
+
+    // wb_̃`FbN
+    const cacheHeader *const h(reinterpret_cast<const cacheHeader *>(file.data()));
+    if (memcmp(h->magic, "GGOC", 4) != 0 || h->version != 4 || h->flags != flags
+      || h->time != time || h->size != size || h->levels == 0) return false;
+
+    // ef[^t@CɎ܂Ă邩ׂ
+    const GLuint64 length[] =
+    {
+      sizeof (GLuint[2]) * h->ng * h->levels,
+      sizeof (GLfloat[4]) * h->ng,
+      sizeof (GLfloat[4]) * h->ng,
+      sizeof (GLfloat[4]) * h->ng,
+      sizeof (GLfloat) * h->ng,
+      sizeof (GLfloat[3]) * h->nv,
+      sizeof (GLfloat[3]) * h->nv,
+      sizeof (GLuint[3]) * h->nf,
+      (flags & cacheLod) ? sizeof (GLfloat) * h->levels : 0,
+      0
+    };
+    for (int i = 0; i < 10; ++i)
+    {
+      if (h->offset[i] > file.size() || length[i] > file.size() - h->offset[i]) return false;
+    }
+
+    // MTL t@CςĂȂׂ
+    GLuint64 offset(h->offset[9]);
+    sources.clear();
+    for (GLuint i = 0; i < h->sources; ++i)
+    {
+      if (sizeof (cacheSource) > file.size() - offset) return false;
+      const cacheSource *const s(reinterpret_cast<const cacheSource *>(file.data() + offset));
+      offset += sizeof (cacheSource);
+      if (s->length > file.size() - offset) return false;
+
+      GLint64 t, n;
+      sources.push_back(std::string(reinterpret_cast<const char *>(file.data() + offset), s->length));
+      fileStamp(sources.back(), t, n);
+      if (t != s->time || n != s->size) return false;
+      offset += (s->length + 7) & ~7;
+      if (offset > file.size()) return false;
+    }
+
+    // ̊m (Ăяö͏ĂȂƂ̂, ׂĊmۂłĂݒ肷)
+    GLuint (*cgroup)[2](nullptr), (*cface)[3](nullptr);
+    GLfloat (*camb)[4](nullptr), (*cdiff)[4](nullptr), (*cspec)[4](nullptr), *cshi(nullptr);
+    GLfloat (*cpos)[3](nullptr), (*cnorm)[3](nullptr), *cerror(nullptr);
+    try
+    {
+      cgroup = new GLuint[h->ng * h->levels][2];
+      camb = new GLfloat[h->ng][4];
+      cdiff = new GLfloat[h->ng][4];
+      cspec = new GLfloat[h->ng][4];
+      cshi = new GLfloat[h->ng];
+      cpos = new GLfloat[h->nv][3];
+      cnorm = new GLfloat[h->nv][3];
+      if (flags & cacheIndexed) cface = new GLuint[h->nf][3];
+      if (flags & cacheLod) cerror = new GLfloat[h->levels];
+    }
+    catch (const std::bad_alloc &)
+    {
+      delete[] cgroup;
+      delete[] camb;
+      delete[] cdiff;
+      delete[] cspec;
+      delete[] cshi;
+      delete[] cpos;
+      delete[] cnorm;
+      delete[] cface;
+      delete[] cerror;
+      return false;
+    }
+    group = cgroup;
+    amb = camb;
+    diff = cdiff;
+    spec = cspec;
+    shi = cshi;
+    pos = cpos;
+    norm = cnorm;
+    face = cface;
+    error = cerror;
+
+    // }bvf[^͂ɕʂ
+    void *const data[] = { group, amb, diff, spec, shi, pos, norm, face, error };
+    for (int i = 0; i < 9; ++i)
+    {
+      if (data[i]) memcpy(data[i], file.data() + h->offset[i], static_cast<size_t>(length[i]));
+    }
+    for (int i = 0; i < 6; ++i) box[i] = h->box[i];
+    ng = h->ng;
+    nv = h->nv;
+    nl = h->levels;
+    nf = h->nf;
+
+    return true;
+  }
+
+  // bVLbVۑ
+  static void saveCache(const std::string &path, const char *suffix, GLuint flags,
+    const std::vector<std::string> &sources, const float *box,
+    GLuint ng, const GLuint (*group)[2], const GLfloat (*amb)[4], const GLfloat (*diff)[4],
+    const GLfloat (*spec)[4], const GLfloat *shi, GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
+    GLuint nl, const GLfloat *error, GLuint nf, const GLuint (*face)[3])
+  {
+    // wb_
+    cacheHeader header = { { 'G', 'G', 'O', 'C' }, 4, ng, nv, nf, static_cast<GLuint>(sources.size()), flags, nl };
+    fileStamp(path, header.time, header.size);
+    for (int i = 0; i < 6; ++i) header.box[i] = box[i];
+
+    // ރf[^ƃoCg
+    const void *const data[] = { group, amb, diff, spec, shi, pos, norm, face, error };
+    const GLuint64 length[] =
+    {
+      sizeof (GLuint[2]) * ng * nl,
+      sizeof (GLfloat[4]) * ng,
+      sizeof (GLfloat[4]) * ng,
+      sizeof (GLfloat[4]) * ng,
+      sizeof (GLfloat) * ng,
+      sizeof (GLfloat[3]) * nv,
+      sizeof (GLfloat[3]) * nv,
+      sizeof (GLuint[3]) * nf,
+      error ? sizeof (GLfloat) * nl : 0
+    };
+
+    // ef[^̈ʒuoCgEɂ낦
+    GLuint64 offset(sizeof header);
+    for (int i = 0; i < 10; ++i)
+    {
+      offset = (offset + cacheAlignment - 1) / cacheAlignment * cacheAlignment;
+      header.offset[i] = offset;
+      if (i < 9) offset += length[i];
+    }
+
+    // t@CJ
+    const std::string cachename(path + suffix);
+    std::ofstream file(cachename.c_str(), std::ios::binary);
+    if (!file)
+    {
+      std::cerr << "Warning: Can't open mesh cache: " << cachename << std::endl;
+      return;
+    }
+
+    // wb_
+    file.write(reinterpret_cast<const char *>(&header), sizeof header);
+
+    // ef[^oCgE낦ď
+    static const char padding[cacheAlignment] = { 0 };
+    GLuint64 position(sizeof header);
+    for (int i = 0; i < 10; ++i)
+    {
+      file.write(padding, static_cast<std::streamsize>(header.offset[i] - position));
+      position = header.offset[i];
+      if (i < 9 && length[i] > 0)
+      {
+        file.write(static_cast<const char *>(data[i]), static_cast<std::streamsize>(length[i]));
+        position += length[i];
+      }
+    }
+
+    // MTL t@C̍XVƃpX
+    for (std::vector<std::string>::const_iterator it = sources.begin(); it != sources.end(); ++it)
+    {
+      cacheSource s;
+      fileStamp(*it, s.time, s.size);
+      s.length = static_cast<GLuint>(it->size());
+      s.reserved = 0;
+      file.write(reinterpret_cast<const char *>(&s), sizeof s);
+      file.write(it->data(), it->size());
+      file.write(padding, static_cast<std::streamsize>(((s.length + 7) & ~7) - s.length));
+    }
+
+    // ݂Ɏsr܂ŏt@CĂ
+    if (file.bad())
+    {
+      std::cerr << "Warning: Can't write mesh cache: " << cachename << std::endl;
+      file.close();
+      remove(cachename.c_str());
+      return;
+    }
+
+    // t@C
+    file.close();
+  }
+}
+// \endcond
+
+/*!
+** \brief OBJ t@C̓ǂݍ݂ɎgXbhݒ肷.
+**
+**   \param threads gpXbh (0 Ȃ玩).
+*/
+void gg::ggObjThreads(unsigned int threads)
+{
+  objThreads = threads;
+}
+
+/*!
+** \brief OBJ t@C̃bVLbVgǂݒ肷.
+**
+**   \param cache true Ȃ烁bVLbVg.
+*/
+void gg::ggObjCache(bool cache)
+{
+  objCache = cache;
+}
+
+/*!
+** \brief OBJ t@CǂݍނƂɃ}eA̒`Ɛ؂ւ\邩ǂݒ肷.
+**
+**   \param verbose true Ȃ\.
+*/
+void gg::ggObjVerbose(bool verbose)
+{
+  objVerbose = verbose;
+}
+
+// \cond STRUCT
+namespace gg
+{
+  // Tipsify ɂOp`̕בւ
+  class tipsify
+  {
+    // Op`̒_CfbNX
+    const GLuint (*const face)[3];
+
+    // _LbV̑傫
+    const GLuint cache;
+
+    // _ƂɋLOp`̃Xg (start[v]  start[v + 1] ܂)
+    std::vector<GLuint> start, adjacency;
+
+    // _Ƃ̂܂o͂ĂȂOp`̐
+    std::vector<GLuint> live;
+
+    // _LbVɓ
+    std::vector<GLuint> stamp;
+
+    // Op`o͂ǂ
+    std::vector<char> emitted;
+
+    // s~܂肩߂邽߂̒_̃X^bN
+    std::vector<GLuint> dead;
+
+    // ɐ̒Sɂ钸_̌
+    std::vector<GLuint> candidates;
+
+    // ݂̎
+    GLuint time;
+
+  public:
+
+    // RXgN^
+    tipsify(GLuint nv, GLuint nf, const GLuint (*face)[3], GLuint cache)
+      : face(face), cache(cache), start(nv + 1, 0), live(nv, 0), stamp(nv, 0), emitted(nf, 1), time(cache + 1)
+    {
+      // _ƂɋLOp`̐𐔂ėݐϘa߂
+      for (GLuint t = 0; t < nf; ++t)
+      {
+        for (int i = 0; i < 3; ++i) ++start[face[t][i] + 1];
+      }
+      for (GLuint v = 0; v < nv; ++v) start[v + 1] += start[v];
+
+      // _ƂɋLOp`o^
+      adjacency.resize(start[nv]);
+      std::vector<GLuint> fill(start.begin(), start.end() - 1);
+      for (GLuint t = 0; t < nf; ++t)
+      {
+        for (int i = 0; i < 3; ++i) adjacency[fill[face[t][i]]++] = t;
+      }
+    }
+
+    // first Ԗڂ count ̎Op`בւ order ɒǉ, s~܂Ŕ񂾈ʒu boundary ɒǉ
+    void run(GLuint first, GLuint count, std::vector<GLuint> &order, std::vector<GLuint> &boundary)
+    {
+      // בւOp`𖢏o͂ɂ
+      for (GLuint t = first; t < first + count; ++t)
+      {
+        emitted[t] = 0;
+        for (int i = 0; i < 3; ++i) ++live[face[t][i]];
+      }
+
+      // s~܂Ŏ̒_Tʒu
+      const GLuint *cursor(face[first]);
+      const GLuint *const end(face[first + count]);
+
+      // ŏ̎Op`̒_n߂
+      GLuint f(count > 0 ? face[first][0] : ~0u);
+      while (f != ~0u)
+      {
+        // f L܂o͂ĂȂOp`o͂
+        candidates.clear();
+        for (GLuint a = start[f]; a < start[f + 1]; ++a)
+        {
+          const GLuint t(adjacency[a]);
+          if (emitted[t]) continue;
+          emitted[t] = 1;
+          order.push_back(t);
+
+          for (int i = 0; i < 3; ++i)
+          {
+            const GLuint v(face[t][i]);
+            dead.push_back(v);
+            candidates.push_back(v);
+            --live[v];
+
+            // LbVɖΓ
+            if (time - stamp[v] > cache) stamp[v] = time++;
+          }
+        }
+
+        // LLbVɎcĂłÂ_̒Sɂ
+        f = ~0u;
+        GLuint priority(0);
+        for (std::vector<GLuint>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+        {
+          const GLuint v(*it);
+          if (live[v] == 0) continue;
+          const GLuint age(time - stamp[v]);
+          const GLuint p(age + 2 * live[v] <= cache ? age + 1 : 1);
+          if (p > priority)
+          {
+            priority = p;
+            f = v;
+          }
+        }
+
+        // ₪΍s~܂Ȃ̂ŒOɎg_͏̒_ɖ߂
+        if (f == ~0u)
+        {
+          while (!dead.empty())
+          {
+            const GLuint v(dead.back());
+            dead.pop_back();
+            if (live[v] > 0)
+            {
+              f = v;
+              break;
+            }
+          }
+          while (f == ~0u && cursor < end)
+          {
+            const GLuint v(*cursor++);
+            if (live[v] > 0) f = v;
+          }
+          if (f != ~0u) boundary.push_back(static_cast<GLuint>(order.size()));
+        }
+      }
+      dead.clear();
+    }
+  };
+
+  // _LbV (FIFO) ŎOp``Ƃ̃LbV~XƎgꂽ_̐𐔂
+  static void countMisses(GLuint nf, const GLuint (*face)[3], GLuint cache, GLuint &misses, GLuint &unique)
+  {
+    // _LbVɓƂ̃LbV~X̐ (0 Ȃ܂gĂȂ)
+    std::vector<GLuint> stamp;
+
+    misses = unique = 0;
+    for (GLuint t = 0; t < nf; ++t)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        const GLuint v(face[t][i]);
+        if (v >= stamp.size()) stamp.resize(v + 1, 0);
+        if (stamp[v] == 0) ++unique;
+        if (stamp[v] == 0 || misses - stamp[v] + 1 > cache) stamp[v] = ++misses;
+      }
+    }
+  }
+
+  // Op`𒸓_LbVƏdȂɍ킹ĖʃO[vƂɕבւ
+  static void optimizeTriangles(GLuint nv, const GLfloat (*pos)[3], GLuint nf, GLuint (*face)[3],
+    GLuint ng, const GLuint (*group)[2], GLuint cache, GLfloat threshold)
+  {
+    if (nf == 0) return;
+
+    // `Ŝ̒S
+    GLfloat center[3] = { 0.0f, 0.0f, 0.0f };
+    for (GLuint v = 0; v < nv; ++v)
+    {
+      center[0] += pos[v][0];
+      center[1] += pos[v][1];
+      center[2] += pos[v][2];
+    }
+    if (nv > 0)
+    {
+      center[0] /= static_cast<GLfloat>(nv);
+      center[1] /= static_cast<GLfloat>(nv);
+      center[2] /= static_cast<GLfloat>(nv);
+    }
+
+    // ʃO[vΑŜ̖ʃO[vɂ
+    const GLuint whole[1][2] = { { 0, nf * 3 } };
+    if (ng == 0 || group == nullptr)
+    {
+      ng = 1;
+      group = whole;
+    }
+
+    // _LbVɍ킹ĕׂOp`̔ԍƍs~܂Ŕ񂾈ʒu
+    tipsify sorter(nv, nf, face, cache);
+    std::vector<GLuint> order, boundary;
+
+    // בւOp`̒_CfbNX
+    std::vector<GLuint> sorted(face[0], face[nf]);
+
+    // NX^ɕƂɒ_LbV͋[邽߂̒_LbVɓƃLbV~X̐
+    std::vector<GLuint> stamp(nv, 0);
+    GLuint misses(0);
+
+    for (GLuint g = 0; g < ng; ++g)
+    {
+      const GLuint first(group[g][0] / 3), count(group[g][1] / 3);
+
+      // _LbVɍ킹ĕׂ
+      order.clear();
+      boundary.clear();
+      sorter.run(first, count, order, boundary);
+      boundary.push_back(count);
+
+      // בւOp``Ƃ̃LbV~X̐
+      GLuint base(misses);
+      for (GLuint i = 0; i < count; ++i)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          const GLuint v(face[order[i]][k]);
+          if (stamp[v] <= base || misses - stamp[v] + 1 > cache) stamp[v] = ++misses;
+        }
+      }
+      const GLfloat limit(threshold * GLfloat(misses - base) / GLfloat(count > 0 ? count : 1));
+
+      // s~܂Ŕ񂾂Ƃ납LbV~X̊Ŝ threshold {ƂŃNX^ɕ
+      struct cluster
+      {
+        GLuint begin, end;
+        GLfloat key;
+        bool operator<(const cluster &o) const { return key > o.key; }
+      };
+      std::vector<cluster> clusters;
+      GLuint begin(0);
+      base = misses;
+      for (GLuint i = 0, b = 0; i < count; ++i)
+      {
+        // NX^̐擪ŃLbVɂȂ̂ƂĒ_LbV͋[
+        for (int k = 0; k < 3; ++k)
+        {
+          const GLuint v(face[order[i]][k]);
+          if (stamp[v] <= base || misses - stamp[v] + 1 > cache) stamp[v] = ++misses;
+        }
+
+        // NX^̋؂
+        while (boundary[b] <= i) ++b;
+        if (i + 1 == boundary[b] || GLfloat(misses - base) < limit * GLfloat(i + 1 - begin))
+        {
+          const cluster c = { begin, i + 1, 0.0f };
+          clusters.push_back(c);
+          begin = i + 1;
+          base = misses;
+        }
+      }
+
+      // NX^̖ʐςŏd݂SƖ@OĂ̂قǐɕ`
+      for (std::vector<cluster>::iterator c = clusters.begin(); c != clusters.end(); ++c)
+      {
+        GLfloat centroid[3] = { 0.0f, 0.0f, 0.0f }, normal[3] = { 0.0f, 0.0f, 0.0f }, area(0.0f);
+        for (GLuint i = c->begin; i < c->end; ++i)
+        {
+          const GLfloat *const p0(pos[face[order[i]][0]]);
+          const GLfloat *const p1(pos[face[order[i]][1]]);
+          const GLfloat *const p2(pos[face[order[i]][2]]);
+          const GLfloat d1[] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+          const GLfloat d2[] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+          const GLfloat n[] =
+          {
+            d1[1] * d2[2] - d1[2] * d2[1],
+            d1[2] * d2[0] - d1[0] * d2[2],
+            d1[0] * d2[1] - d1[1] * d2[0]
+          };
+          const GLfloat a(sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]));
+          for (int k = 0; k < 3; ++k)
+          {
+            normal[k] += n[k];
+            centroid[k] += (p0[k] + p1[k] + p2[k]) * a;
+          }
+          area += a;
+        }
+        const GLfloat l(sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]));
+        if (area > 0.0f && l > 0.0f)
+        {
+          c->key = ((centroid[0] / (3.0f * area) - center[0]) * normal[0]
+            + (centroid[1] / (3.0f * area) - center[1]) * normal[1]
+            + (centroid[2] / (3.0f * area) - center[2]) * normal[2]) / l;
+        }
+      }
+      std::stable_sort(clusters.begin(), clusters.end());
+
+      // בւOp`
+      GLuint *dst(&sorted[first * 3]);
+      for (std::vector<cluster>::const_iterator c = clusters.begin(); c != clusters.end(); ++c)
+      {
+        for (GLuint i = c->begin; i < c->end; ++i)
+        {
+          *dst++ = face[order[i]][0];
+          *dst++ = face[order[i]][1];
+          *dst++ = face[order[i]][2];
+        }
+      }
+    }
+
+    std::copy(sorted.begin(), sorted.end(), face[0]);
+  }
+
+  // ǂݍ񂾌`쐬`œKƂ̒_LbV̑傫ƃNX^ɕ ACMR ̂l
+  static const GLuint optimizeCache(16);
+  static const GLfloat optimizeThreshold(1.05f);
+
+  // `̍œK̑O̒_LbV̌\
+  static void reportMisses(const char *name, GLuint before, GLuint after, GLuint unique, GLuint nf, GLuint cache)
+  {
+    std::cerr << name << ": " << nf << " triangles, cache " << cache
+      << ", ACMR " << GLfloat(before) / GLfloat(nf) << " -> " << GLfloat(after) / GLfloat(nf)
+      << ", ATVR " << GLfloat(before) / GLfloat(unique) << " -> " << GLfloat(after) / GLfloat(unique) << std::endl;
+  }
+}
+// \endcond
+
+/*!
+** \brief ǂݍ񂾌`쐬`œK邩ǂݒ肷.
+**
+**   \param optimize true Ȃ ggOptimizeMesh() ŎOp`ƒ_בւ.
+*/
+void gg::ggMeshOptimize(bool optimize)
+{
+  objOptimize = optimize;
+}
+
+/*!
+** \brief _LbV̌߂.
+**
+**   \param nf Op`.
+**   \param face Op`̒_CfbNX.
+**   \param cache _LbV (FIFO) ̑傫.
+**   \param acmr Op`̃LbV~X̐ (ACMR) i[ϐ.
+**   \param atvr gꂽ_̃LbV~X̐ (ATVR) i[ϐ.
+*/
+void gg::ggMeshStats(GLuint nf, const GLuint (*face)[3], GLuint cache, GLfloat &acmr, GLfloat &atvr)
+{
+  GLuint misses, unique;
+  countMisses(nf, face, cache, misses, unique);
+  acmr = nf > 0 ? GLfloat(misses) / GLfloat(nf) : 0.0f;
+  atvr = unique > 0 ? GLfloat(misses) / GLfloat(unique) : 0.0f;
+}
+
+/*!
+** \brief Op`ƒ_̏œK.
+**
+**   \param nv _.
+**   \param pos _̈ʒu.
+**   \param norm _̖@ (nullptr ȂבւȂ).
+**   \param nf Op`.
+**   \param face Op`̒_CfbNX.
+**   \param ng ʃO[v (0 ȂŜ̖ʃO[vɂ).
+**   \param group ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+**   \param cache _LbV (FIFO) ̑傫.
+**   \param threshold NX^ɕ ACMR ̂l (בւ ACMR ɑ΂).
+*/
+void gg::ggOptimizeMesh(GLuint nv, GLfloat (*pos)[3], GLfloat (*norm)[3], GLuint nf, GLuint (*face)[3],
+  GLuint ng, const GLuint (*group)[2], GLuint cache, GLfloat threshold)
+{
+  if (nf == 0) return;
+
+  // ʃO[vƂɎOp`בւ
+  optimizeTriangles(nv, pos, nf, face, ng, group, cache, threshold);
+
+  // _ŏɎg鏇ɕtւ
+  std::vector<GLuint> remap(nv, ~0u);
+  GLuint next(0);
+  for (GLuint *i = face[0]; i < face[nf]; ++i)
+  {
+    if (remap[*i] == ~0u) remap[*i] = next++;
+    *i = remap[*i];
+  }
+
+  // gȂ_͌̏Ɍɒu
+  for (GLuint v = 0; v < nv; ++v)
+  {
+    if (remap[v] == ~0u) remap[v] = next++;
+  }
+
+  // _f[^בւ
+  std::vector<GLfloat> temp(nv * 3);
+  GLfloat (*const data[])[3] = { pos, norm };
+  for (int k = 0; k < 2; ++k)
+  {
+    if (data[k] == nullptr) continue;
+    std::copy(data[k][0], data[k][nv], temp.begin());
+    for (GLuint v = 0; v < nv; ++v)
+    {
+      std::copy(&temp[v * 3], &temp[v * 3] + 3, data[k][remap[v]]);
+    }
+  }
+}
+
+// \cond STRUCT
+namespace gg
+{
+  // _̓񎟌덷s (Ώ 4x4 s̏Op 10 vfƏd)
+  struct quadric
+  {
+    double a[10];
+    double w;
+
+    //  nx x + ny y + nz z + d = 0 ܂ł̋̓d w ŉ
+    void add(double nx, double ny, double nz, double d, double w)
+    {
+      a[0] += w * nx * nx;
+      a[1] += w * nx * ny;
+      a[2] += w * nx * nz;
+      a[3] += w * nx * d;
+      a[4] += w * ny * ny;
+      a[5] += w * ny * nz;
+      a[6] += w * ny * d;
+      a[7] += w * nz * nz;
+      a[8] += w * nz * d;
+      a[9] += w * d * d;
+      this->w += w;
+    }
 
-    // @̒߂Ă
-    const float nl(sqrt(nx * nx + ny * ny + nz * nz));
+    // ̓񎟌덷s̘aœ_ p ̕ʂ܂ł̋̓̏dݕtς߂
+    static double error(const quadric &q, const quadric &r, const GLfloat *p)
+    {
+      double a[10];
+      for (int i = 0; i < 10; ++i) a[i] = q.a[i] + r.a[i];
+      const double x(p[0]), y(p[1]), z(p[2]), w(q.w + r.w);
+      const double e(a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x
+        + a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y
+        + a[7] * z * z + 2.0 * a[8] * z
+        + a[9]);
+      return w > 0.0 ? std::max(e, 0.0) / w : 0.0;
+    }
+  };
 
-    // @߂
-    nmap[i][0] = nx / nl;
-    nmap[i][1] = ny / nl;
-    nmap[i][2] = nz / nl;
-    nmap[i][3] = hmap[o];
-  }
+  // _ڂ̌
+  struct collapse
+  {
+    GLfloat cost;                           // ڂƂ̌덷
+    GLuint u, v;                            // u  v Ɉڂ
+    GLuint version;                         // ߂Ƃ u ̔
 
-  // }bv̉摜̓ǂݍ݂Ɏg
-  delete[] hmap;
+    // 덷̏̂Ɏo
+    bool operator<(const collapse &o) const
+    {
+      return cost > o.cost || (cost == o.cost && u > o.u);
+    }
+  };
 
-  // tH[}bg_eNX`łȂ [0,1] ɕϊ
-  if (
-    internal != GL_RGB16F  &&
-    internal != GL_RGBA16F &&
-    internal != GL_RGB32F  &&
-    internal != GL_RGBA32F
-    )
+  // _ԍʒu̎ɔr
+  struct position
   {
-    for (GLsizei i = 0; i < maxsize; ++i)
+    const GLfloat (*const pos)[3];
+    position(const GLfloat (*pos)[3]) : pos(pos) {}
+    bool operator()(GLuint a, GLuint b) const
     {
-      nmap[i][0] = nmap[i][0] * 0.5f + 0.5f;
-      nmap[i][1] = nmap[i][1] * 0.5f + 0.5f;
-      nmap[i][2] = nmap[i][2] * 0.5f + 0.5f;
-      nmap[i][3] *= 0.0039215686f; // == 1/255
+      return std::lexicographical_compare(pos[a], pos[a] + 3, pos[b], pos[b] + 3);
     }
-  }
+  };
 
-  // eNX`IuWFNg
-  GLuint tex;
-  glGenTextures(1, &tex);
-  glBindTexture(GL_TEXTURE_2D, tex);
+  // ӂ̏kɂ`̊ȗ
+  class simplifier
+  {
+    const GLfloat (*const pos)[3];
+    std::vector<GLuint> face;               // Op`݂̌̒_CfbNX
+    std::vector<char> dead;                 // kŏOp`
+    std::vector<std::vector<GLuint> > adjacency;  // _LOp`
+    std::vector<quadric> quadrics;          // _̓񎟌덷s
+    std::vector<char> locked;               // Ȃ_
+    std::vector<char> removed;              // kŏ_
+    std::vector<GLuint> version;            // _̌̔
+    std::vector<GLuint> mark;               // אڒ_̈
+    GLuint stamp;                           // אڒ_̈̒l
+    std::priority_queue<collapse> heap;     // ǩ
+
+    // Op`̖@ (KȂ)
+    void normal(const GLfloat *p0, const GLfloat *p1, const GLfloat *p2, double *n) const
+    {
+      const double d1[] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+      const double d2[] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+      n[0] = d1[1] * d2[2] - d1[2] * d2[1];
+      n[1] = d1[2] * d2[0] - d1[0] * d2[2];
+      n[2] = d1[0] * d2[1] - d1[1] * d2[0];
+    }
 
-  // nmap  GLfloat Ȃ̂ 4 oCgEɐݒ肷
-  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    // _ u  v ɈڂƂɗԂOp`񑽗l̂łȂׂ
+    bool valid(GLuint u, GLuint v)
+    {
+      // u ̗אڒ_Ɉ
+      if (++stamp == 0)
+      {
+        std::fill(mark.begin(), mark.end(), 0);
+        stamp = 1;
+      }
+      GLuint shared(0);
+      for (std::vector<GLuint>::const_iterator t = adjacency[u].begin(); t != adjacency[u].end(); ++t)
+      {
+        if (dead[*t]) continue;
+        const GLuint *const f(&face[*t * 3]);
+        for (int i = 0; i < 3; ++i) mark[f[i]] = stamp;
+        if (f[0] == v || f[1] == v || f[2] == v)
+        {
+          //  uv LOp`
+          ++shared;
+          continue;
+        }
 
-  // eNX`蓖Ă
-  glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0, GL_RGBA, GL_FLOAT, nmap);
+        // ڂ̖@̖@ƋtɂȂΈڂȂ
+        double n0[3], n1[3];
+        normal(pos[f[0]], pos[f[1]], pos[f[2]], n0);
+        normal(pos[f[0] == u ? v : f[0]], pos[f[1] == u ? v : f[1]], pos[f[2] == u ? v : f[2]], n1);
+        if (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0) return false;
+      }
 
-  // oCjAi~bv}bvȂjCGbWŃNv
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+      // u  v ɋʂ̗אڒ_ uv LOp`̐葽Δ񑽗l̂ɂȂ
+      GLuint common(0);
+      for (std::vector<GLuint>::const_iterator t = adjacency[v].begin(); t != adjacency[v].end(); ++t)
+      {
+        if (dead[*t]) continue;
+        const GLuint *const f(&face[*t * 3]);
+        for (int i = 0; i < 3; ++i)
+        {
+          if (f[i] != u && f[i] != v && mark[f[i]] == stamp)
+          {
+            mark[f[i]] = 0;
+            ++common;
+          }
+        }
+      }
+      return shared > 0 && common == shared;
+    }
 
-  // @}bv̍쐬Ɏg
-  delete[] nmap;
+  public:
 
-  // eNX`IuWFNgԂ
-  return tex;
+    // `̊ȗŐő̌덷 (̓)
+    double maximum;
+
+    // cĂOp`̐
+    GLuint live;
+
+    // RXgN^
+    simplifier(GLuint nv, const GLfloat (*pos)[3], GLuint nf, const GLuint (*face)[3],
+      GLuint ng, const GLuint (*group)[2])
+      : pos(pos), face(face[0], face[nf]), dead(nf, 0), adjacency(nv), quadrics(nv),
+      locked(nv, 0), removed(nv, 0), version(nv, 0), mark(nv, 0), stamp(0), maximum(0.0), live(nf)
+    {
+      // Op`̖ʃO[vԍ
+      std::vector<GLuint> tgroup(nf, 0);
+      for (GLuint g = 0; g < ng; ++g)
+      {
+        for (GLuint t = group[g][0] / 3; t < (group[g][0] + group[g][1]) / 3 && t < nf; ++t) tgroup[t] = g;
+      }
+
+      // ʒu_ (@̕sAȌp) ͓Ȃ
+      std::vector<GLuint> order(nv);
+      for (GLuint v = 0; v < nv; ++v) order[v] = v;
+      std::sort(order.begin(), order.end(), position(pos));
+      for (GLuint i = 1; i < nv; ++i)
+      {
+        if (std::equal(pos[order[i]], pos[order[i]] + 3, pos[order[i - 1]]))
+        {
+          locked[order[i]] = locked[order[i - 1]] = 1;
+        }
+      }
+
+      // قȂʃO[vɑOp`L钸_͓Ȃ
+      std::vector<GLuint> vgroup(nv, ~0u);
+      for (GLuint t = 0; t < nf; ++t)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          const GLuint v(face[t][i]);
+          if (vgroup[v] == ~0u) vgroup[v] = tgroup[t];
+          else if (vgroup[v] != tgroup[t]) locked[v] = 1;
+        }
+      }
+
+      // ̎Op`Ȃ (E) ̒_͓Ȃ
+      std::vector<GLuint64> edges;
+      edges.reserve(nf * 3);
+      for (GLuint t = 0; t < nf; ++t)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          const GLuint a(face[t][i]), b(face[t][(i + 1) % 3]);
+          edges.push_back(static_cast<GLuint64>(std::min(a, b)) << 32 | std::max(a, b));
+        }
+      }
+      std::sort(edges.begin(), edges.end());
+      for (size_t i = 0; i < edges.size(); )
+      {
+        size_t j(i + 1);
+        while (j < edges.size() && edges[j] == edges[i]) ++j;
+        if (j - i == 1)
+        {
+          locked[static_cast<GLuint>(edges[i] >> 32)] = 1;
+          locked[static_cast<GLuint>(edges[i] & 0xffffffff)] = 1;
+        }
+        i = j;
+      }
+
+      // _LOp`Ɩʐςŏd݂񎟌덷s߂
+      memset(&quadrics[0], 0, sizeof (quadric) * nv);
+      for (GLuint t = 0; t < nf; ++t)
+      {
+        const GLuint *const f(face[t]);
+        double n[3];
+        normal(pos[f[0]], pos[f[1]], pos[f[2]], n);
+        const double l(sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]));
+        if (l > 0.0)
+        {
+          const double nx(n[0] / l), ny(n[1] / l), nz(n[2] / l);
+          const double d(-(nx * pos[f[0]][0] + ny * pos[f[0]][1] + nz * pos[f[0]][2]));
+          for (int i = 0; i < 3; ++i) quadrics[f[i]].add(nx, ny, nz, d, l * 0.5);
+        }
+        for (int i = 0; i < 3; ++i) adjacency[f[i]].push_back(t);
+      }
+
+      // ׂĂ̒_ɂďǩ߂
+      for (GLuint v = 0; v < nv; ++v) update(v);
+    }
+
+    // _ u ڂ̌߂
+    void update(GLuint u)
+    {
+      ++version[u];
+      if (locked[u] || removed[u]) return;
+
+      // Op`菜Ȃאڒ_̂덷ŏ̂̂T
+      std::vector<GLuint> &adj(adjacency[u]);
+      size_t n(0);
+      for (size_t i = 0; i < adj.size(); ++i) if (!dead[adj[i]]) adj[n++] = adj[i];
+      adj.resize(n);
+      collapse best = { FLT_MAX, u, ~0u, version[u] };
+      for (std::vector<GLuint>::const_iterator t = adj.begin(); t != adj.end(); ++t)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          const GLuint v(face[*t * 3 + i]);
+          if (v == u) continue;
+          const GLfloat cost(static_cast<GLfloat>(quadric::error(quadrics[u], quadrics[v], pos[v])));
+          if (cost < best.cost || (cost == best.cost && v < best.v))
+          {
+            best.cost = cost;
+            best.v = v;
+          }
+        }
+      }
+      if (best.v != ~0u) heap.push(best);
+    }
+
+    // Op` target ȉɂȂ܂ŏk񂷂
+    void reduce(GLuint target)
+    {
+      while (live > target && !heap.empty())
+      {
+        const collapse c(heap.top());
+        heap.pop();
+
+        // Â͎̂Ă
+        if (c.version != version[c.u] || removed[c.u] || removed[c.v]) continue;
+
+        // Ԃ񑽗l̂ɂȂ肷ȂڂȂ
+        if (!valid(c.u, c.v)) continue;
+
+        // u  v Ɉڂĕ uv LOp`
+        for (std::vector<GLuint>::const_iterator t = adjacency[c.u].begin(); t != adjacency[c.u].end(); ++t)
+        {
+          if (dead[*t]) continue;
+          GLuint *const f(&face[*t * 3]);
+          if (f[0] == c.v || f[1] == c.v || f[2] == c.v)
+          {
+            dead[*t] = 1;
+            --live;
+            continue;
+          }
+          for (int i = 0; i < 3; ++i) if (f[i] == c.u) f[i] = c.v;
+          adjacency[c.v].push_back(*t);
+        }
+        for (int i = 0; i < 10; ++i) quadrics[c.v].a[i] += quadrics[c.u].a[i];
+        quadrics[c.v].w += quadrics[c.u].w;
+        removed[c.u] = 1;
+        adjacency[c.u].clear();
+        maximum = std::max(maximum, static_cast<double>(c.cost));
+
+        // v Ƃ̗אڒ_̌ߒ
+        update(c.v);
+        if (++stamp == 0)
+        {
+          std::fill(mark.begin(), mark.end(), 0);
+          stamp = 1;
+        }
+        mark[c.v] = stamp;
+        const std::vector<GLuint> adj(adjacency[c.v]);
+        for (std::vector<GLuint>::const_iterator t = adj.begin(); t != adj.end(); ++t)
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            const GLuint w(face[*t * 3 + i]);
+            if (mark[w] == stamp) continue;
+            mark[w] = stamp;
+            update(w);
+          }
+        }
+      }
+    }
+
+    // cĂOp`̏ɏo
+    GLuint (*write(GLuint (*out)[3]) const)[3]
+    {
+      for (size_t t = 0; t < dead.size(); ++t)
+      {
+        if (dead[t]) continue;
+        std::copy(&face[t * 3], &face[t * 3] + 3, *out++);
+      }
+      return out;
+    }
+
+    // ʃO[v͈̔͂ƂɎcĂOp`̐𐔂
+    GLuint count(GLuint first, GLuint last) const
+    {
+      GLuint n(0);
+      for (GLuint t = first; t < last; ++t) if (!dead[t]) ++n;
+      return n;
+    }
+  };
+
+  // ǂݍ񂾌`󂩂ڍדx̒iK̏ƈiKƂɎcOp`̊
+  static const GLuint lodLevels(8);
+  static const GLfloat lodRatio(0.5f);
 }
+// \endcond
 
-// \cond STRUCT
-/*
-** OBJ t@C̓ǂݍ݂Ɏgf[^^
+/*!
+** \brief 񎟌덷ɂӂ̏kŏڍדx (LOD) ̒iK.
 **
-**     Vine Linux 6.1  gcc 4.4.5 , [Jɒ`
-**     NXE\̂ template ŎgƃG[ɂȂ.
+**   \param nv _.
+**   \param pos _̈ʒu.
+**   \param nf Op`.
+**   \param face Op`̒_CfbNX.
+**   \param ng ʃO[v (0 ȂŜ̖ʃO[vɂ).
+**   \param group ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+**   \param levels 쐬iK̏ (̌`܂).
+**   \param ratio iKƂɎcOp`̊.
+**   \param nl 쐬iKi[ϐ.
+**   \param lnf ׂĂ̒iK̎Op`̍vi[ϐ.
+**   \param lface ׂĂ̒iK̎Op`̒_CfbNXi[̃|C^i[ϐ.
+**   \param lgroup iKƂ̖ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐i[̃|C^i[ϐ.
+**   \param lerror iKƂ̈ʒǔ덷i[̃|C^i[ϐ.
+**   \return 쐬ɐ true.
 */
-namespace gg
+bool gg::ggSimplifyMesh(GLuint nv, const GLfloat (*pos)[3], GLuint nf, const GLuint (*face)[3],
+  GLuint ng, const GLuint (*group)[2], GLuint levels, GLfloat ratio,
+  GLuint &nl, GLuint &lnf, GLuint (*&lface)[3], GLuint (*&lgroup)[2], GLfloat *&lerror)
 {
-  // F
-  struct rgb
-  {
-    float r, g, b;
-  };
-
-  // }eA
-  struct mat
+  // ɏlݒ肷
+  nl = lnf = 0;
+  lface = nullptr;
+  lgroup = nullptr;
+  lerror = nullptr;
+
+  // ʃO[vΑŜ̖ʃO[vɂ
+  const GLuint whole[1][2] = { { 0, nf * 3 } };
+  if (ng == 0 || group == nullptr)
   {
-    rgb amb;      // ambient
-    rgb diff;     // diffuse
-    rgb spec;     // specular
-    float shi;    // shininess
-    float dis;    // dissolve
-  };
+    ng = 1;
+    group = whole;
+  }
 
-  // xNg
-  struct vec
+  try
   {
-    float x, y, z;
-  };
+    // iKƂ̎Op`̒_CfbNXƖʃO[v̎Op`ƌ덷
+    std::vector<GLuint> indices(face[0], face[nf]);
+    std::vector<GLuint> counts;
+    std::vector<GLfloat> errors;
+
+    // ̌`ŏ̒iKɂ
+    for (GLuint g = 0; g < ng; ++g) counts.push_back(group[g][1] / 3);
+    errors.push_back(0.0f);
+
+    // Op`炵ȂiK
+    simplifier s(nv, pos, nf, face, ng, group);
+    GLfloat target(static_cast<GLfloat>(nf));
+    for (GLuint l = 1; l < levels; ++l)
+    {
+      // Op`قƂǌȂȂI
+      const GLuint before(s.live);
+      target *= ratio;
+      s.reduce(static_cast<GLuint>(target));
+      if (s.live == 0 || s.live > before - before / 16) break;
+
+      // ̒iK̎Op`̏ɒǉ
+      const size_t base(indices.size());
+      indices.resize(base + s.live * 3);
+      s.write(reinterpret_cast<GLuint (*)[3]>(&indices[base]));
+      for (GLuint g = 0; g < ng; ++g)
+      {
+        counts.push_back(s.count(group[g][0] / 3, (group[g][0] + group[g][1]) / 3));
+      }
+      errors.push_back(static_cast<GLfloat>(sqrt(s.maximum)));
+    }
 
-  // ʃf[^
-  struct idx
+    // ʂi[
+    nl = static_cast<GLuint>(errors.size());
+    lnf = static_cast<GLuint>(indices.size() / 3);
+    lface = new GLuint[lnf][3];
+    lgroup = new GLuint[nl * ng][2];
+    lerror = new GLfloat[nl];
+    std::copy(indices.begin(), indices.end(), lface[0]);
+    std::copy(errors.begin(), errors.end(), lerror);
+    GLuint first(0);
+    for (GLuint i = 0; i < nl * ng; ++i)
+    {
+      lgroup[i][0] = first;
+      lgroup[i][1] = counts[i] * 3;
+      first += lgroup[i][1];
+    }
+  }
+  catch (const std::bad_alloc &)
   {
-    GLuint p[3];  // _Wԍ
-    GLuint n[3];  // _@ԍ
-    GLuint t[3];  // eNX`Wԍ
-    bool smooth;  // X[YVF[fBO̗L
-  };
+    delete[] lface;
+    delete[] lgroup;
+    delete[] lerror;
+    nl = lnf = 0;
+    lface = nullptr;
+    lgroup = nullptr;
+    lerror = nullptr;
+    return false;
+  }
 
-  // ʃO[v
-  struct grp
-  {
-    GLuint b;     // ʃO[v̊Jnԍ
-    GLuint c;     // ʃO[v̒_
-    const mat *m; // ʃO[ṽ}eA
-    grp(GLuint begin, GLuint count, const mat &material)
-      : b(begin), c(count), m(&material) {}
-  };
+  return true;
 }
-// \endcond
 
 /*!
 ** \brief Op`ꂽ OBJ t@Cǂݍ.
@@ -5619,87 +9455,37 @@ namespace gg
 bool gg::ggLoadObj(const char *name, GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
   GLuint &nf, GLuint (*&face)[3], bool normalize)
 {
-  // OBJ t@C̓ǂݍ
-  std::ifstream file(name, std::ios::binary);
+  // OBJ t@CɃ}bv
+  GgMappedFile file(name);
 
   // t@CJȂ߂
-  if (!file)
+  if (!file.data())
   {
     std::cerr << "Error: Can't open OBJ file: " << name << std::endl;
     return false;
   }
 
-  // sǂݍݗp̃obt@
-  std::string line;
-
-  // f[^̐ƍWl̍ŏlEől
-  float xmin, xmax, ymin, ymax, zmin, zmax;
-  xmax = ymax = zmax = -(xmin = ymin = zmin = FLT_MAX);
-
-  // _ʒüꎞۑ
-  std::vector<vec> tpos;
-  std::vector<idx> tface;
+  // _ʒuƖʂ̈ꎞۑ
+  std::vector<chunk> chunks;
+  arena temp;
+  elements t;
 
-  // f[^ǂݍ
-  while (std::getline(file, line))
-  {
-    std::istringstream str(line);
-    std::string op;
-    str >> op;
-
-    if (op == "v")
-    {
-      // _ʒu
-      vec v;
-
-      // _ʒu̓Xy[Xŋ؂Ă
-      str >> v.x >> v.y >> v.z;
-
-      // ʒu̍őlƍŏl߂ (AABB)
-      xmin = std::min(xmin, v.x);
-      xmax = std::max(xmax, v.x);
-      ymin = std::min(ymin, v.y);
-      ymax = std::max(ymax, v.y);
-      zmin = std::min(zmin, v.z);
-      zmax = std::max(zmax, v.z);
-
-      // _f[^ۑ
-      tpos.push_back(v);
-    }
-    else if (op == "f")
-    {
-      // ʃf[^
-      idx f;
-
-      // _Wԍo
-      for (int i = 0; i < 3; ++i)
-      {
-        // 1sXy[Xŋ؂ČX̗vf̍ŏ̐lo
-        std::string s;
-        str >> s;
-        f.p[i] = atoi(s.c_str());
-      }
-
-      // ʃf[^ۑ
-      tface.push_back(f);
-    }
-  }
+  // Wl̍ŏlEől
+  float box[6];
 
-  // t@C̓ǂݍ݃`FbN
-  if (file.bad())
-  {
-    // ܂ǂݍ߂Ȃ
-    std::cerr << "Warning: Can't read OBJ file: " << name << std::endl;
-  }
+  // }bvt@C𕪊ēǂݍ
+  const char *const text(reinterpret_cast<const char *>(file.data()));
+  loadChunks(text, file.size(), false, chunks, temp, t, box);
+  const float &xmin(box[0]), &xmax(box[1]), &ymin(box[2]), &ymax(box[3]), &zmin(box[4]), &zmax(box[5]);
 
-  // t@C
+  // ͂It@C̃}bv
   file.close();
 
   // ̊m
   pos = norm = nullptr;
   face = nullptr;
-  nv = static_cast<GLuint>(tpos.size());
-  nf = static_cast<GLuint>(tface.size());
+  nv = t.nv;
+  nf = t.nf;
   try
   {
     pos = new GLfloat[nv][3];
@@ -5741,61 +9527,39 @@ bool gg::ggLoadObj(const char *name, GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&
     cx = cy = cz = 0.0f;
   }
 
-  // }`̑傫ƈʒu̐Kƃf[^̃Rs[
-  for (std::vector<vec>::const_iterator it = tpos.begin(); it != tpos.end(); ++it)
+  // }`̑傫ƈʒu̐Kƃf[^̃Rs[ (@͐Kʒuŋ߂)
+  for (vec *it = t.pos; it != t.pos + nv; ++it)
   {
-    const size_t v = it - tpos.begin();
+    const size_t v = it - t.pos;
 
-    pos[v][0] = (it->x - cx) * scale;
-    pos[v][1] = (it->y - cy) * scale;
-    pos[v][2] = (it->z - cz) * scale;
+    pos[v][0] = it->x = (it->x - cx) * scale;
+    pos[v][1] = it->y = (it->y - cy) * scale;
+    pos[v][2] = it->z = (it->z - cz) * scale;
   }
 
-  // _@̒l 0 ɂĂ
-  std::fill(static_cast<GLfloat *>(&norm[0][0]), static_cast<GLfloat *>(&norm[nv][0]), 0.0f);
-
-  // ʂ̖@̎Zoƃf[^̃Rs[
-  for (std::vector<idx>::const_iterator it = tface.begin(); it != tface.end(); ++it)
+  // _Wԍo
+  for (const idx *it = t.face; it != t.face + nf; ++it)
   {
-    const size_t f(it - tface.begin());
-
-    // _Wԍo
-    const GLuint v0(face[f][0] = it->p[0] - 1);
-    const GLuint v1(face[f][1] = it->p[1] - 1);
-    const GLuint v2(face[f][2] = it->p[2] - 1);
-
-    // v1 - v0, v2 - v0 ߂
-    const GLfloat dx1(pos[v1][0] - pos[v0][0]);
-    const GLfloat dy1(pos[v1][1] - pos[v0][1]);
-    const GLfloat dz1(pos[v1][2] - pos[v0][2]);
-    const GLfloat dx2(pos[v2][0] - pos[v0][0]);
-    const GLfloat dy2(pos[v2][1] - pos[v0][1]);
-    const GLfloat dz2(pos[v2][2] - pos[v0][2]);
-
-    // Oςɂʖ@߂
-    const GLfloat nx(dy1 * dz2 - dz1 * dy2);
-    const GLfloat ny(dz1 * dx2 - dx1 * dz2);
-    const GLfloat nz(dx1 * dy2 - dy1 * dx2);
-
-    // ʖ@𒸓_@ɐώZ
-    norm[v0][0] += nx;
-    norm[v0][1] += ny;
-    norm[v0][2] += nz;
-    norm[v1][0] += nx;
-    norm[v1][1] += ny;
-    norm[v1][2] += nz;
-    norm[v2][0] += nx;
-    norm[v2][1] += ny;
-    norm[v2][2] += nz;
+    const size_t f(it - t.face);
+    face[f][0] = it->p[0] - 1;
+    face[f][1] = it->p[1] - 1;
+    face[f][2] = it->p[2] - 1;
   }
 
+  // ʂ̖@𒸓_@ɏW߂
+  computeNormals(temp, t, true);
+
   // _@̐K
   for (GLuint v = 0; v < nv; ++v)
   {
     // _@̒
-    GLfloat a(sqrt(norm[v][0] * norm[v][0] + norm[v][1] * norm[v][1] + norm[v][2] * norm[v][2]));
+    const vec &n(t.norm[v]);
+    GLfloat a(sqrt(n.x * n.x + n.y * n.y + n.z * n.z));
 
     // _@̐K
+    norm[v][0] = n.x;
+    norm[v][1] = n.y;
+    norm[v][2] = n.z;
     if (a != 0.0)
     {
       norm[v][0] /= a;
@@ -5804,561 +9568,613 @@ bool gg::ggLoadObj(const char *name, GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&
     }
   }
 
-  return true;
-}
-
-/*!
-** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍ.
-**
-**   \param name OBJ t@C.
-**   \param ng ǂݍ񂾃f[^̖ʂ̃O[v.
-**   \param group ʂ̊eO[v̍ŏ̖ʂ̔ԍƖʂ̐.
-**   \param amb O[vƂ̊ɑ΂锽ˌW.
-**   \param diff O[vƂ̊gUˌW.
-**   \param spec O[vƂ̋ʔˌW.
-**   \param shi O[vƂ̋PW.
-**   \param nv ǂݍ񂾃f[^̒_i[ϐ.
-**   \param pos _̈ʒũf[^i[̃|C^i[ϐ.
-**   \param norm _̖@f[^̊i[̃|C^i[ϐ.
-**   \param normalize true ȂTCY𐳋K.
-**   \return ǂݍ݂ɐ true.
-*/
-bool gg::ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
-  GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
-  GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3], bool normalize)
-{
-  // ɏlݒ肷
-  ng = 0;
-  group = nullptr;
-  amb = diff = spec = nullptr;
-  shi = nullptr;
-  nv = 0;
-  pos = norm = nullptr;
-
-  // t@CpXfBNgo
-  std::string path(name);
-  const size_t base(path.find_last_of("/\\"));
-  std::string dirname((base == std::string::npos) ? "" : path.substr(base + 1));
-
-  // OBJ t@Cǂݍ
-  std::ifstream file(path.c_str());
-
-  // ǂݍ݂Ɏs߂
-  if (!file)
-  {
-    std::cerr << "Error: Can't open OBJ file: " << path << std::endl;
-    return false;
-  }
-
-  // }eA
-  std::map<std::string, mat> mtl;
-  static const char defmtl[] = "Default";
-  std::string mtlname(defmtl);
-
-  // ftHg̃}eA
-  mtl[mtlname].amb.r = 0.1f;
-  mtl[mtlname].amb.g = 0.1f;
-  mtl[mtlname].amb.b = 0.1f;
-  mtl[mtlname].diff.r = 0.6f;
-  mtl[mtlname].diff.g = 0.6f;
-  mtl[mtlname].diff.b = 0.6f;
-  mtl[mtlname].spec.r = 0.3f;
-  mtl[mtlname].spec.g = 0.3f;
-  mtl[mtlname].spec.b = 0.3f;
-  mtl[mtlname].shi = 60.0f;
-  mtl[mtlname].dis = 1.0f;
-
-  // ǂݍݗp̈ꎞL̈
-  std::vector<vec> tpos;
-  std::vector<vec> ttex;
-  std::vector<vec> tnorm;
-  std::vector<idx> tface;
-  std::vector<grp> tgroup;
-
-  // O[v̊Jnԍ
-  GLuint groupbegin(0);
-
-  // X[YVF[fBÕXCb`
-  bool smooth(false);
-
-  // Wl̍ŏlEől
-  float xmin, xmax, ymin, ymax, zmin, zmax;
-  xmax = ymax = zmax = -(xmin = ymin = zmin = FLT_MAX);
-
-  // sǂݍݗp̃obt@
-  std::string line;
+  return true;
+}
 
-  // f[^̓ǂݍ
-  while (std::getline(file, line))
+// \cond STRUCT
+namespace gg
+{
+  // Op`ꂽ OBJ t@C MTL t@C𐳋Kɓǂݍ
+  static bool loadObjArrays(const std::string &path, GLuint &ng, GLuint (*&group)[2],
+    GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+    GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3], float *box, std::vector<std::string> &sources)
   {
-    // Ō̕ \r Ȃ폜
-    if (*(line.end() - 1) == '\r') line.erase(--line.end());
-
-    // s𕶎Xg[ɓ
-    std::istringstream str(line);
+    // ɏlݒ肷
+    ng = 0;
+    group = nullptr;
+    amb = diff = spec = nullptr;
+    shi = nullptr;
+    nv = 0;
+    pos = norm = nullptr;
 
-    // ŏ̃g[N𖽗 (op) Ƃ݂Ȃ
-    std::string op;
-    str >> op;
+    // t@CpXfBNgo
+    const size_t base(path.find_last_of("/\\"));
+    std::string dirname((base == std::string::npos) ? "" : path.substr(base + 1));
 
-    if (op == "v")
+    // OBJ t@CςĂȂ΃bVLbVg
+    GLuint cl, cf;
+    GLfloat *cerror;
+    GLuint (*cface)[3];
+    if (objCache && loadCache(path, ".ggm", 0, sources, ng, group, amb, diff, spec, shi, nv, pos, norm, cl, cerror, cf, cface, box))
     {
-      // _ʒu
-      vec v;
-
-      // _ʒu̓Xy[Xŋ؂Ă
-      str >> v.x >> v.y >> v.z;
-
-      // _ʒu̍ŏlƍől߂ (AABB)
-      xmin = std::min(xmin, v.x);
-      xmax = std::max(xmax, v.x);
-      ymin = std::min(ymin, v.y);
-      ymax = std::max(ymax, v.y);
-      zmin = std::min(zmin, v.z);
-      zmax = std::max(zmax, v.z);
-
-      // _ʒuL^
-      tpos.push_back(v);
+      return true;
     }
-    else if (op == "vt")
-    {
-      // eNX`W
-      vec t;
+    sources.clear();
 
-      // _ʒu̓Xy[Xŋ؂Ă
-      str >> t.x >> t.y;
+    // OBJ t@CɃ}bv
+    GgMappedFile file(path.c_str());
 
-      // eNX`WL^
-      ttex.push_back(t);
-    }
-    else if (op == "vn")
+    // ǂݍ݂Ɏs߂
+    if (!file.data())
     {
-      // _@
-      vec n;
-
-      // _@̓Xy[Xŋ؂Ă
-      str >> n.x >> n.y >> n.z;
-
-      // _@L^
-      tnorm.push_back(n);
+      std::cerr << "Error: Can't open OBJ file: " << path << std::endl;
+      return false;
     }
-    else if (op == "f")
-    {
-      //  (Op`) f[^
-      idx f;
 
-      // X[XVF[fBO
-      f.smooth = smooth;
-
-      //@O_̂ꂼɂ
-      for (int i = 0; i < 3; ++i)
+    // }eA
+    std::map<std::string, mat> mtl;
+    static const char defmtl[] = "Default";
+    std::string mtlname(defmtl);
+
+    // ftHg̃}eA
+    mtl[mtlname].amb.r = 0.1f;
+    mtl[mtlname].amb.g = 0.1f;
+    mtl[mtlname].amb.b = 0.1f;
+    mtl[mtlname].diff.r = 0.6f;
+    mtl[mtlname].diff.g = 0.6f;
+    mtl[mtlname].diff.b = 0.6f;
+    mtl[mtlname].spec.r = 0.3f;
+    mtl[mtlname].spec.g = 0.3f;
+    mtl[mtlname].spec.b = 0.3f;
+    mtl[mtlname].shi = 60.0f;
+    mtl[mtlname].dis = 1.0f;
+
+    // ǂݍݗp̈ꎞL̈
+    std::vector<chunk> chunks;
+    arena temp;
+    elements t;
+    std::vector<grp> tgroup;
+
+    // }bvt@C𕪊ēǂݍ
+    const char *const text(reinterpret_cast<const char *>(file.data()));
+    loadChunks(text, file.size(), true, chunks, temp, t, box);
+
+    // ʃO[v̐ usemtl ̐̂𒴂Ȃ
+    size_t events(1);
+    for (std::vector<chunk>::const_iterator c = chunks.begin(); c != chunks.end(); ++c) events += c->events.size();
+    tgroup.reserve(events);
+
+    // O[v̊Jnԍ
+    GLuint groupbegin(0);
+
+    // ʂ̏Ԃς閽߂t@C̏ɏĖʃO[v
+    for (std::vector<chunk>::const_iterator c = chunks.begin(); c != chunks.end(); ++c)
+    {
+      for (std::vector<event>::const_iterator e = c->events.begin(); e != c->events.end(); ++e)
       {
-        // Pڎo
-        std::string s;
-        str >> s;
-
-        // ڂ̍ŏ̗vf͒_Wԍ
-        f.p[i] = atoi(s.c_str());
-        f.t[i] = f.n[i] = 0;
-
-        // c̍ڂo
-        size_t l(s.find('/', 0));
-        if (l != std::string::npos)
+        if (e->op == event::usemtl)
         {
-          // ڂ̍ڂ̐擪̈ʒu
-          ++l;
+          // ʃO[v̖ʐ
+          GLuint groupcount((c->bf + e->face) * 3 - groupbegin);
+          if (groupcount > 0)
+          {
+            // ʃO[v̒_f[^̊JnԍƐCт̃}eAL^
+            grp b(groupbegin, groupcount, mtl[mtlname]);
+            tgroup.push_back(b);
 
-          // ڂ̍ڂ̓eNX`W
-          f.t[i] = atoi(s.c_str() + l);
+            // ̖ʃO[v̊Jnԍ߂Ă
+            groupbegin += groupcount;
+          }
 
-          // Oڂ̍
-          l = s.find('/', l);
-          if (l != std::string::npos)
-          {
-            // Oڂ̍ڂ̐擪̈ʒu
-            ++l;
+          // }eA̎o
+          if (e->n > 0) mtlname.assign(e->t, e->n);
 
-            // Oڂ̍ڂ͖@ԍ
-            f.n[i] = atoi(s.c_str() + l);
+          // }eȂ݃`FbN
+          if (mtl.find(mtlname) == mtl.end())
+          {
+            std::cerr << "Warning: Undefined material: " << mtlname << std::endl;
+            mtlname = defmtl;
+          }
+          else if (objVerbose)
+          {
+            std::cerr << "usemtl: " << mtlname << std::endl;
           }
         }
+        else if (e->op == event::mtllib)
+        {
+          // MTL t@C̃pXēǂݍ
+          sources.push_back(dirname + std::string(e->t, e->n));
+          loadMtl(sources.back(), mtl, mtlname);
+        }
       }
-
-      // ʃf[^̋L^
-      tface.push_back(f);
-    }
-    else if (op == "s")
-    {
-      // '1' X[XVF[fBOL
-      std::string s;
-      str >> s;
-      smooth = s == "1";
     }
-    else if (op == "usemtl")
-    {
-      // ʃO[v̖ʐ
-      GLuint groupcount(static_cast<GLuint>(tface.size()) * 3 - groupbegin);
-      if (groupcount > 0)
-      {
-        // ʃO[v̒_f[^̊JnԍƐCт̃}eAL^
-        grp b(groupbegin, groupcount, mtl[mtlname]);
-        tgroup.push_back(b);
 
-        // ̖ʃO[v̊Jnԍ߂Ă
-        groupbegin += groupcount;
-      }
+    // }eAot@C̃}bv
+    file.close();
 
-      // }eA̎o
-      str >> mtlname;
+    // Ō̖ʃO[v̖ʐ
+    GLuint groupcount(t.nf * 3 - groupbegin);
+    if (groupcount > 0)
+    {
+      // Ō̖ʃO[v̒_f[^̊JnԍƐCт̃}eAL^
+      grp b(groupbegin, groupcount, mtl[mtlname]);
+      tgroup.push_back(b);
+    }
 
-      // }eȂ݃`FbN
-      if (mtl.find(mtlname) == mtl.end())
+    // usemtl ŋ؂ꂽʂ̕т𓯂}eAƂɍŏɌꂽɂ܂Ƃ߂ĖʃO[vɂ
+    std::vector<grp> truns;
+    truns.swap(tgroup);
+    std::vector<size_t> owner(truns.size());
+    std::map<const mat *, size_t> merged;
+    for (std::vector<grp>::const_iterator it = truns.begin(); it != truns.end(); ++it)
+    {
+      const std::map<const mat *, size_t>::const_iterator m(merged.find(it->m));
+      if (m == merged.end())
       {
-        std::cerr << "Warning: Undefined material: " << mtlname << std::endl;
-        mtlname = defmtl;
+        owner[it - truns.begin()] = merged[it->m] = tgroup.size();
+        tgroup.push_back(grp(0, 0, *it->m));
       }
       else
       {
-        std::cerr << "usemtl: " << mtlname << std::endl;
+        owner[it - truns.begin()] = m->second;
       }
+      tgroup[owner[it - truns.begin()]].c += it->c;
+    }
+
+    // ʃO[v̊Jnԍ߂, eт̊i[߂
+    std::vector<GLuint> target(truns.size()), filled(tgroup.size(), 0);
+    for (std::vector<grp>::iterator it = tgroup.begin(); it != tgroup.end(); ++it)
+    {
+      it->b = it == tgroup.begin() ? 0 : (it - 1)->b + (it - 1)->c;
     }
-    else if (op == "mtllib")
+    for (size_t r = 0; r < truns.size(); ++r)
     {
-      // MTL t@C̃pX
-      str >> std::ws;
-      std::string mtlpath;
-      std::getline(str, mtlpath);
-      mtlpath = dirname + mtlpath;
+      target[r] = tgroup[owner[r]].b + filled[owner[r]];
+      filled[owner[r]] += truns[r].c;
+    }
 
-      // MTL t@CJ
-      std::ifstream mtlfile(mtlpath.c_str(), std::ios::binary);
-      if (!mtlfile)
-      {
-        // MTL t@CƂ
-        std::cerr << "Warning: Can't open MTL file: " << mtlpath << std::endl;
-      }
-      else
+    // KvȖʐ
+    const GLuint nf(t.nf);
+
+    // ̊m
+    try
+    {
+      // KvȒ_
+      nv = nf * 3;
+      pos = norm = nullptr;
+
+      pos = new GLfloat[nv][3];
+      norm = new GLfloat[nv][3];
+
+      // KvȃO[v
+      ng = static_cast<GLuint>(tgroup.size());
+      group = nullptr;
+      amb = diff = spec = nullptr;
+      shi = nullptr;
+
+      group = new GLuint[ng][2];
+      amb = new GLfloat[ng][4];
+      diff = new GLfloat[ng][4];
+      spec = new GLfloat[ng][4];
+      shi = new GLfloat[ng];
+    }
+    catch (const std::bad_alloc &)
+    {
+      delete[] pos;
+      delete[] norm;
+
+      nv = 0;
+      pos = norm = nullptr;
+
+      delete[] group;
+      delete[] amb;
+      delete[] diff;
+      delete[] spec;
+      delete[] shi;
+
+      ng = 0;
+      group = nullptr;
+      amb = diff = spec = nullptr;
+      shi = nullptr;
+
+      return false;
+    }
+
+    // @f[^ȂΎZoĂ
+    if (t.nn == 0) computeNormals(temp, t, false);
+
+    // ʂƂ̒_f[^𓯂}eA̖ʃO[vɂ܂Ƃ߂Ȃ쐬
+    for (std::vector<grp>::const_iterator r = truns.begin(); r != truns.end(); ++r)
+    {
+      // ̕т̍ŏƍŌ̖
+      const idx *const first(t.face + r->b / 3), *const last(first + r->c / 3);
+
+      for (const idx *it = first; it != last; ++it)
       {
-        // sǂݍݗp̃obt@
-        std::string mtlline;
+        const GLuint f(target[r - truns.begin()] + static_cast<GLuint>((it - first) * 3));
 
-        // }eAf[^ǂݍ
-        while (std::getline(mtlfile, mtlline))
+        // O_̂ꂼɂ
+        for (int i = 0; i < 3; ++i)
         {
-          std::istringstream mtlstr(mtlline);
-          std::string mtlop;
-          mtlstr >> mtlop;
+          const unsigned int v(f + i);
 
-          if (mtlop == "newmtl")
-          {
-            // VK}eAo͂
-            mtlstr >> mtlname;
-            std::cerr << "newmtl: " << mtlname << std::endl;
-          }
-          else if (mtlop == "Ka")
-          {
-            // ̔ˌWo^
-            mtlstr >> mtl[mtlname].amb.r >> mtl[mtlname].amb.g >> mtl[mtlname].amb.b;
-          }
-          else if (mtlop == "Kd")
-          {
-            // gUˌWo^
-            mtlstr >> mtl[mtlname].diff.r >> mtl[mtlname].diff.g >> mtl[mtlname].diff.b;
-          }
-          else if (mtlop == "Ks")
+          // _Wԍ
+          GLuint p(it->p[i]);
+          if (p > 0)
           {
-            // ʔˌWo^
-            mtlstr >> mtl[mtlname].spec.r >> mtl[mtlname].spec.g >> mtl[mtlname].spec.b;
+            --p;
+
+            // _Wo^ (K̓bVLbVۑɍs)
+            pos[v][0] = t.pos[p].x;
+            pos[v][1] = t.pos[p].y;
+            pos[v][2] = t.pos[p].z;
           }
-          else if (mtlop == "Ns")
+
+#if 0
+          // eNX`Wԍ
+          GLuint c(it->t[i]);
+          if (c > 0)
           {
-            // PWo^
-            mtlstr >> mtl[mtlname].shi;
+            --c;
+
+            // eNX`Wo^
+            tex[v][0] = t.tex[c].x;
+            tex[v][1] = t.tex[c].y;
           }
-          else if (mtlop == "d")
+#endif
+
+          // _@ԍ
+          GLuint n(it->n[i]);
+          if (n > 0)
           {
-            // sxo^
-            mtlstr >> mtl[mtlname].dis;
+            --n;
+
+            GLfloat nx(t.norm[n].x);
+            GLfloat ny(t.norm[n].y);
+            GLfloat nz(t.norm[n].z);
+
+            if (it->smooth)
+            {
+              GLfloat a(sqrt(nx * nx + ny * ny + nz * nz));
+              if (a != 0.0f)
+              {
+                nx /= a;
+                ny /= a;
+                nz /= a;
+              }
+            }
+
+            // _@o^
+            norm[v][0] = nx;
+            norm[v][1] = ny;
+            norm[v][2] = nz;
           }
         }
-
-        // MTL t@C̓ǂݍ݃`FbN
-        if (mtlfile.bad())
-        {
-          // MTL t@C܂ǂݍ߂Ȃ
-          std::cerr << "Warning: Can't read MTL file: " << mtlpath << std::endl;
-        }
-        mtlfile.close();
       }
     }
-  }
-
-  // t@C̓ǂݍ݃`FbN
-  if (file.bad())
-  {
-    // OBJ t@C܂ǂݍ߂Ȃ
-    std::cerr << "Error: Can't read OBJ file: " << path << std::endl;
-    file.close();
-    return false;
-  }
-
-  // t@C
-  file.close();
-
-  // Ō̖ʃO[v̖ʐ
-  GLuint groupcount(static_cast<GLuint>(tface.size()) * 3 - groupbegin);
-  if (groupcount > 0)
-  {
-    // Ō̖ʃO[v̒_f[^̊JnԍƐCт̃}eAL^
-    grp b(groupbegin, groupcount, mtl[mtlname]);
-    tgroup.push_back(b);
-  }
-
-  // KvȖʐ
-  const GLuint nf(static_cast<GLuint>(tface.size()));
-
-  // ̊m
-  try
-  {
-    // KvȒ_
-    nv = nf * 3;
-    pos = norm = nullptr;
 
-    pos = new GLfloat[nv][3];
-    norm = new GLfloat[nv][3];
+    // ʃO[vf[^̍쐬
+    for (std::vector<grp>::const_iterator it = tgroup.begin(); it != tgroup.end(); ++it)
+    {
+      const size_t g(it - tgroup.begin());
+
+      // ʃO[v̍ŏ̒_ʒuԍ
+      group[g][0] = it->b;
+
+      // ʃO[v̒_f[^̐
+      group[g][1] = it->c;
+
+      // ʃO[v̊ɑ΂锽ˌW
+      amb[g][0] = it->m->amb.r;
+      amb[g][1] = it->m->amb.g;
+      amb[g][2] = it->m->amb.b;
+      amb[g][3] = 1.0f;
+
+      // ʃO[v̊gUˌW
+      diff[g][0] = it->m->diff.r;
+      diff[g][1] = it->m->diff.g;
+      diff[g][2] = it->m->diff.b;
+      diff[g][3] = it->m->dis;
+
+      // ʃO[v̋ʔˌW
+      spec[g][0] = it->m->spec.r;
+      spec[g][1] = it->m->spec.g;
+      spec[g][2] = it->m->spec.b;
+      spec[g][3] = 1.0f;
+
+      // ʃO[v̋PW
+      shi[g] = it->m->shi;
+    }
 
-    // KvȃO[v
-    ng = static_cast<GLuint>(tgroup.size());
-    group = nullptr;
-    amb = diff = spec = nullptr;
-    shi = nullptr;
+    // KO̒_ʒuŃbVLbVۑ
+    if (objCache) saveCache(path, ".ggm", 0, sources, box, ng, group, amb, diff, spec, shi, nv, pos, norm, 1, nullptr, 0, nullptr);
 
-    group = new GLuint[ng][2];
-    amb = new GLfloat[ng][4];
-    diff = new GLfloat[ng][4];
-    spec = new GLfloat[ng][4];
-    shi = new GLfloat[ng];
+    return true;
   }
-  catch (std::bad_alloc e)
-  {
-    delete[] pos;
-    delete[] norm;
+}
+// \endcond
 
-    nv = 0;
-    pos = norm = nullptr;
+/*!
+** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍ.
+**
+**   \param name OBJ t@C.
+**   \param ng ǂݍ񂾃f[^̖ʂ̃O[v.
+**   \param group ʂ̊eO[v̍ŏ̖ʂ̔ԍƖʂ̐.
+**   \param amb O[vƂ̊ɑ΂锽ˌW.
+**   \param diff O[vƂ̊gUˌW.
+**   \param spec O[vƂ̋ʔˌW.
+**   \param shi O[vƂ̋PW.
+**   \param nv ǂݍ񂾃f[^̒_i[ϐ.
+**   \param pos _̈ʒũf[^i[̃|C^i[ϐ.
+**   \param norm _̖@f[^̊i[̃|C^i[ϐ.
+**   \param normalize true ȂTCY𐳋K.
+**   \return ǂݍ݂ɐ true.
+*/
+bool gg::ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
+  GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+  GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3], bool normalize)
+{
+  // Wl̍ŏlEől
+  float box[6];
 
-    delete[] group;
-    delete[] amb;
-    delete[] diff;
-    delete[] spec;
-    delete[] shi;
+  // Kɓǂݍ
+  std::vector<std::string> sources;
+  if (!loadObjArrays(name, ng, group, amb, diff, spec, shi, nv, pos, norm, box, sources)) return false;
 
-    ng = 0;
-    group = nullptr;
-    amb = diff = spec = nullptr;
-    shi = nullptr;
+  // ʒuƑ傫𐳋K
+  if (normalize) normalizeObj(nv, pos, box);
 
-    return false;
-  }
+  return true;
+}
 
-  // ʒuƑ傫𐳋K邽߂̌W
-  GLfloat scale, cx, cy, cz;
-  if (normalize)
+// \cond STRUCT
+namespace gg
+{
+  // Op`ꂽ OBJ t@C MTL t@C𐳋Kɏd̂Ȃ_ƃCfbNXœǂݍ
+  static bool loadObjElements(const char *name, GLuint &ng, GLuint (*&group)[2],
+    GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+    GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
+    GLuint &nf, GLuint (*&face)[3], float *box, std::vector<std::string> &sources)
   {
-    const float sx(xmax - xmin);
-    const float sy(ymax - ymin);
-    const float sz(zmax - zmin);
+    // ɏlݒ肷
+    nf = 0;
+    face = nullptr;
 
-    scale = sx;
-    if (sy > scale) scale = sy;
-    if (sz > scale) scale = sz;
-    scale = (scale != 0.0f) ? 2.0f / scale : 1.0f;
+    // bVLbV̓eƒiK
+    GLuint nl;
+    GLfloat *error;
+    const GLuint flags(cacheIndexed | (objOptimize ? cacheOptimized : 0));
 
-    cx = (xmax + xmin) * 0.5f;
-    cy = (ymax + ymin) * 0.5f;
-    cz = (zmax + zmin) * 0.5f;
-  }
-  else
-  {
-    scale = 1.0f;
-    cx = cy = cz = 0.0f;
-  }
+    // OBJ t@CςĂȂ΃bVLbVg
+    if (objCache && loadCache(name, ".ggi", flags, sources, ng, group, amb, diff, spec, shi, nv, pos, norm, nl, error, nf, face, box))
+    {
+      return true;
+    }
 
-  // @f[^ȂΎZoĂ
-  if (tnorm.empty())
-  {
-    // @f[^̏l͒_ƓŃX[YVF[fBÔ߂ɏl 0
-    static const vec zero = { 0.0f, 0.0f, 0.0f };
-    tnorm.resize(tpos.size(), zero);
+    // Op`ƂɓWJ_f[^
+    GLuint nc;
+    GLfloat (*cpos)[3], (*cnorm)[3];
 
-    // ʂ̖@̎Zoƒ_@̎Zo
-    for (std::vector<idx>::iterator it = tface.begin(); it != tface.end(); ++it)
+    // Arrays `ŐKɓǂݍ
+    if (!loadObjArrays(name, ng, group, amb, diff, spec, shi, nc, cpos, cnorm, box, sources))
     {
-      // _Wԍ
-      const GLuint v0(it->p[0] - 1);
-      const GLuint v1(it->p[1] - 1);
-      const GLuint v2(it->p[2] - 1);
+      nv = 0;
+      pos = norm = nullptr;
+      return false;
+    }
 
-      // v1 - v0, v2 - v0 ߂
-      const GLfloat dx1(tpos[v1].x - tpos[v0].x);
-      const GLfloat dy1(tpos[v1].y - tpos[v0].y);
-      const GLfloat dz1(tpos[v1].z - tpos[v0].z);
-      const GLfloat dx2(tpos[v2].x - tpos[v0].x);
-      const GLfloat dy2(tpos[v2].y - tpos[v0].y);
-      const GLfloat dz2(tpos[v2].z - tpos[v0].z);
+    // d̂Ȃ_̔ԍi[nbV\ (JԒn@, 󂫂 ~0)
+    GLuint buckets(1);
+    while (buckets < nc * 2) buckets <<= 1;
+    std::vector<GLuint> table;
 
-      // Oςɂʖ@߂
-      GLfloat nx(dy1 * dz2 - dz1 * dy2);
-      GLfloat ny(dz1 * dx2 - dx1 * dz2);
-      GLfloat nz(dx1 * dy2 - dy1 * dx2);
+    // ̊m
+    nv = 0;
+    pos = norm = nullptr;
+    try
+    {
+      table.assign(buckets, ~0u);
+      nf = nc / 3;
+      face = new GLuint[nf][3];
+    }
+    catch (const std::bad_alloc &)
+    {
+      delete[] cpos;
+      delete[] cnorm;
+      delete[] group;
+      delete[] amb;
+      delete[] diff;
+      delete[] spec;
+      delete[] shi;
+
+      ng = nf = 0;
+      group = nullptr;
+      amb = diff = spec = nullptr;
+      shi = nullptr;
+      face = nullptr;
+
+      return false;
+    }
 
-      if (it->smooth)
-      {
-        // ʖ@𒸓_@ɐώZ
-        tnorm[v0].x += nx;
-        tnorm[v0].y += ny;
-        tnorm[v0].z += nz;
-        tnorm[v1].x += nx;
-        tnorm[v1].y += ny;
-        tnorm[v1].z += nz;
-        tnorm[v2].x += nx;
-        tnorm[v2].y += ny;
-        tnorm[v2].z += nz;
-
-        // ʃf[^XV
-        it->n[0] = it->p[0];
-        it->n[1] = it->p[1];
-        it->n[2] = it->p[2];
-      }
-      else
+    // ʒuƖ@_Oɋl߂Ȃɂ܂Ƃ߂
+    GLuint *const index(face[0]);
+    for (GLuint c = 0; c < nf * 3; ++c)
+    {
+      // ʒuƖ@̃rbg񂩂nbVl߂
+      GLuint key[6];
+      memcpy(key, cpos[c], sizeof cpos[c]);
+      memcpy(key + 3, cnorm[c], sizeof cnorm[c]);
+      GLuint hash(2166136261u);
+      for (int i = 0; i < 6; ++i) hash = (hash ^ key[i]) * 16777619u;
+
+      // _o^ĂȂ΋󂢂ĂƂɓo^
+      GLuint b(hash & (buckets - 1));
+      for (;; b = (b + 1) & (buckets - 1))
       {
-        // ʖ@𐳋K
-        const GLfloat a(sqrt(nx * nx + ny * ny + nz * nz));
-        if (a != 0.0f)
+        const GLuint v(table[b]);
+        if (v == ~0u)
         {
-          nx /= a;
-          ny /= a;
-          nz /= a;
+          if (nv < c)
+          {
+            memcpy(cpos[nv], cpos[c], sizeof cpos[c]);
+            memcpy(cnorm[nv], cnorm[c], sizeof cnorm[c]);
+          }
+          index[c] = table[b] = nv++;
+          break;
+        }
+        if (memcmp(cpos[v], key, sizeof cpos[v]) == 0 && memcmp(cnorm[v], key + 3, sizeof cnorm[v]) == 0)
+        {
+          index[c] = v;
+          break;
         }
-
-        // 3 _ǉ
-        const GLuint v(static_cast<GLuint>(tnorm.size()));
-        tnorm.resize(v + 3);
-
-        // Kʖ@̂܂ܒ_@ɂ
-        tnorm[v + 0].x = nx;
-        tnorm[v + 0].y = ny;
-        tnorm[v + 0].z = nz;
-        tnorm[v + 1].x = nx;
-        tnorm[v + 1].y = ny;
-        tnorm[v + 1].z = nz;
-        tnorm[v + 2].x = nx;
-        tnorm[v + 2].y = ny;
-        tnorm[v + 2].z = nz;
-
-        // ʃf[^XV
-        it->n[0] = v + 1;
-        it->n[1] = v + 2;
-        it->n[2] = v + 3;
       }
     }
-  }
 
-  // ʂƂ̒_f[^̍쐬
-  for (std::vector<idx>::const_iterator it = tface.begin(); it != tface.end(); ++it)
-  {
-    const GLuint f(static_cast<GLuint>((it - tface.begin()) * 3));
+    // d̂Ȃ_f[^Kvȑ傫̃Ɉڂ
+    pos = new(std::nothrow) GLfloat[nv][3];
+    norm = new(std::nothrow) GLfloat[nv][3];
+    if (pos && norm)
+    {
+      memcpy(pos, cpos, sizeof (GLfloat[3]) * nv);
+      memcpy(norm, cnorm, sizeof (GLfloat[3]) * nv);
+      delete[] cpos;
+      delete[] cnorm;
+    }
+    else
+    {
+      // mۂłȂΓWJ_f[^̃̂܂܎g
+      delete[] pos;
+      delete[] norm;
+      pos = cpos;
+      norm = cnorm;
+    }
 
-    // O_̂ꂼɂ
-    for (int i = 0; i < 3; ++i)
+    // Op`ƒ_̏œK
+    if (objOptimize)
     {
-      const unsigned int v(f + i);
+      GLuint before, after, unique;
+      countMisses(nf, face, optimizeCache, before, unique);
+      ggOptimizeMesh(nv, pos, norm, nf, face, ng, group, optimizeCache, optimizeThreshold);
+      countMisses(nf, face, optimizeCache, after, unique);
+      reportMisses(name, before, after, unique, nf, optimizeCache);
+    }
 
-      // _Wԍ
-      GLuint p(it->p[i]);
-      if (p > 0)
-      {
-        --p;
+    // KO̒_ʒuŃbVLbVۑ
+    if (objCache) saveCache(name, ".ggi", flags, sources, box, ng, group, amb, diff, spec, shi, nv, pos, norm, 1, nullptr, nf, face);
 
-        // _W𐳋Kēo^
-        pos[v][0] = (tpos[p].x - cx) * scale;
-        pos[v][1] = (tpos[p].y - cy) * scale;
-        pos[v][2] = (tpos[p].z - cz) * scale;
-      }
+    return true;
+  }
+}
+// \endcond
 
-#if 0
-      // eNX`Wԍ
-      GLuint t(it->t[i]);
-      if (t > 0)
-      {
-        --t;
+/*!
+** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍ (Elements `)
+**
+**   \param name OBJ t@C.
+**   \param ng ǂݍ񂾃f[^̖ʂ̃O[v.
+**   \param group ʂ̊eO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+**   \param amb O[vƂ̊ɑ΂锽ˌW.
+**   \param diff O[vƂ̊gUˌW.
+**   \param spec O[vƂ̋ʔˌW.
+**   \param shi O[vƂ̋PW.
+**   \param nv d̂Ȃ_i[ϐ.
+**   \param pos _̈ʒũf[^i[̃|C^i[ϐ.
+**   \param norm _̖@f[^̊i[̃|C^i[ϐ.
+**   \param nf Op`i[ϐ.
+**   \param face Op`̒_CfbNXi[̃|C^i[ϐ.
+**   \param normalize true ȂTCY𐳋K.
+**   \return ǂݍ݂ɐ true.
+*/
+bool gg::ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
+  GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+  GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
+  GLuint &nf, GLuint (*&face)[3], bool normalize)
+{
+  // Wl̍ŏlEől
+  float box[6];
 
-        // eNX`Wo^
-        tex[v][0] = ttex[t].x;
-        tex[v][1] = ttex[t].y;
-      }
-#endif
+  // Kɓǂݍ
+  std::vector<std::string> sources;
+  if (!loadObjElements(name, ng, group, amb, diff, spec, shi, nv, pos, norm, nf, face, box, sources)) return false;
 
-      // _@ԍ
-      GLuint n(it->n[i]);
-      if (n > 0)
-      {
-        --n;
+  // ʒuƑ傫𐳋K
+  if (normalize) normalizeObj(nv, pos, box);
+
+  return true;
+}
+
+/*!
+** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍŏڍדx (LOD) ̒iK (Elements `)
+**
+**   \param name OBJ t@C.
+**   \param ng ǂݍ񂾃f[^̖ʂ̃O[v.
+**   \param group iKƂ̖ʂ̊eO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+**   \param amb O[vƂ̊ɑ΂锽ˌW.
+**   \param diff O[vƂ̊gUˌW.
+**   \param spec O[vƂ̋ʔˌW.
+**   \param shi O[vƂ̋PW.
+**   \param nv d̂Ȃ_i[ϐ.
+**   \param pos _̈ʒũf[^i[̃|C^i[ϐ.
+**   \param norm _̖@f[^̊i[̃|C^i[ϐ.
+**   \param nl ڍדx̒iKi[ϐ.
+**   \param error iKƂ̈ʒǔ덷i[̃|C^i[ϐ.
+**   \param nf ׂĂ̒iK̎Op`̍vi[ϐ.
+**   \param face ׂĂ̒iK̎Op`̒_CfbNXi[̃|C^i[ϐ.
+**   \param normalize true ȂTCY𐳋K.
+**   \return ǂݍ݂ɐ true.
+*/
+bool gg::ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
+  GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+  GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
+  GLuint &nl, GLfloat *&error, GLuint &nf, GLuint (*&face)[3], bool normalize)
+{
+  // ɏlݒ肷
+  nl = 0;
+  error = nullptr;
 
-        GLfloat nx(tnorm[n].x);
-        GLfloat ny(tnorm[n].y);
-        GLfloat nz(tnorm[n].z);
+  // bVLbV̓e
+  const GLuint flags(cacheIndexed | cacheLod | (objOptimize ? cacheOptimized : 0));
 
-        if (it->smooth)
-        {
-          GLfloat a(sqrt(nx * nx + ny * ny + nz * nz));
-          if (a != 0.0f)
-          {
-            nx /= a;
-            ny /= a;
-            nz /= a;
-          }
-        }
+  // Wl̍ŏlEől
+  float box[6];
 
-        // _@o^
-        norm[v][0] = nx;
-        norm[v][1] = ny;
-        norm[v][2] = nz;
-      }
-    }
-  }
+  // ǂݍ MTL t@C̃pX
+  std::vector<std::string> sources;
 
-  // ʃO[vf[^̍쐬
-  for (std::vector<grp>::const_iterator it = tgroup.begin(); it != tgroup.end(); ++it)
+  // OBJ t@CςĂȂ΃bVLbVg
+  if (!objCache || !loadCache(name, ".ggl", flags, sources, ng, group, amb, diff, spec, shi, nv, pos, norm,
+    nl, error, nf, face, box))
   {
-    const size_t g(it - tgroup.begin());
-
-    // ʃO[v̍ŏ̒_ʒuԍ
-    group[g][0] = it->b;
-
-    // ʃO[v̒_f[^̐
-    group[g][1] = it->c;
+    // d̂Ȃ_ƃCfbNXŐKɓǂݍ
+    if (!loadObjElements(name, ng, group, amb, diff, spec, shi, nv, pos, norm, nf, face, box, sources)) return false;
 
-    // ʃO[v̊ɑ΂锽ˌW
-    amb[g][0] = it->m->amb.r;
-    amb[g][1] = it->m->amb.g;
-    amb[g][2] = it->m->amb.b;
-    amb[g][3] = 1.0f;
-
-    // ʃO[v̊gUˌW
-    diff[g][0] = it->m->diff.r;
-    diff[g][1] = it->m->diff.g;
-    diff[g][2] = it->m->diff.b;
-    diff[g][3] = it->m->dis;
+    // ڍדx̒iK
+    GLuint lnf;
+    GLuint (*lface)[3], (*lgroup)[2];
+    if (!ggSimplifyMesh(nv, pos, nf, face, ng, group, lodLevels, lodRatio, nl, lnf, lface, lgroup, error))
+    {
+      std::cerr << "Warning: Can't simplify: " << name << std::endl;
+      nl = 1;
+      error = new GLfloat[1];
+      error[0] = 0.0f;
+      return true;
+    }
+    delete[] face;
+    delete[] group;
+    nf = lnf;
+    face = lface;
+    group = lgroup;
 
-    // ʃO[v̋ʔˌW
-    spec[g][0] = it->m->spec.r;
-    spec[g][1] = it->m->spec.g;
-    spec[g][2] = it->m->spec.b;
-    spec[g][3] = 1.0f;
+    // KO̒_ʒuŃbVLbVۑ
+    if (objCache) saveCache(name, ".ggl", flags, sources, box, ng, group, amb, diff, spec, shi, nv, pos, norm,
+      nl, error, nf, face);
+  }
 
-    // ʃO[v̋PW
-    shi[g] = it->m->shi;
+  // ʒuƑ傫𐳋KČ덷킹
+  if (normalize)
+  {
+    const GLfloat scale(normalizeObj(nv, pos, box));
+    for (GLuint l = 0; l < nl; ++l) error[l] *= scale;
   }
 
   return true;
@@ -6580,6 +10396,365 @@ GLuint gg::ggLoadShader(const char *vert, const char *frag, const char *geom,
   return program;
 }
 
+// \cond STRUCT
+namespace gg
+{
+  // ԂL^eNX`jbg̐ (ȏ̃jbg̐ݒ͏ȗȂ)
+  const GLuint stateUnits(32);
+
+  // ԂL^eNX`̃^[Qbg
+  const GLenum stateTargets[] = { GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP };
+  const int stateTargetCount(sizeof stateTargets / sizeof stateTargets[0]);
+
+  // eNX`̃p[^
+  struct envParam
+  {
+    GLenum pname;
+    GLfloat value[4];
+  };
+
+  // eNX`jbgƂ̏
+  struct unitState
+  {
+    // ĂeNX` (known  false Ȃs)
+    GLuint texture[stateTargetCount];
+    bool known[stateTargetCount];
+
+    // ݒς݂̃eNX`̃p[^
+    std::vector<envParam> env;
+
+    // eNX`ϊs (matrixKnown  false Ȃs)
+    GLfloat matrix[16];
+    bool matrixKnown;
+  };
+
+  // OpenGL ̏Ԃ̃LbV
+  struct stateCache
+  {
+    // I𒆂̃eNX`jbg (0 Ȃs)
+    GLenum active;
+
+    // eNX`jbgƂ̏
+    unitState unit[stateUnits];
+
+    // gp̃vOƌ̒_zIuWFNg
+    GLuint program, array;
+    bool programKnown, arrayKnown;
+
+    // ݂̐F
+    GLfloat color[4];
+    bool colorKnown;
+
+    // I𒆂̕ϊs (0 Ȃs)
+    GLenum mode;
+
+    // fr[ϊsƓeϊs
+    GLfloat modelview[16], projection[16];
+    bool modelviewKnown, projectionKnown;
+
+    // OpenGL ɑĂяoƏȗĂяỏ
+    GLuint issued, elided;
+
+    stateCache()
+      : issued(0), elided(0)
+    {
+      reset();
+    }
+
+    // ׂĂ̏Ԃsɂ
+    void reset()
+    {
+      active = 0;
+      for (GLuint u = 0; u < stateUnits; ++u)
+      {
+        for (int t = 0; t < stateTargetCount; ++t) unit[u].known[t] = false;
+        unit[u].env.clear();
+        unit[u].matrixKnown = false;
+      }
+      programKnown = arrayKnown = colorKnown = false;
+      mode = 0;
+      modelviewKnown = projectionKnown = false;
+    }
+
+    // I𒆂̃eNX`jbg̏ (L^ȂjbgsȂ nullptr)
+    unitState *current()
+    {
+      return active >= GL_TEXTURE0 && active < GL_TEXTURE0 + stateUnits ? unit + (active - GL_TEXTURE0) : nullptr;
+    }
+
+    // lΏȗ񐔂𐔂 true Ԃ, قȂΒlL^đ񐔂𐔂
+    bool same(GLfloat *cached, bool &known, const GLfloat *value, int n)
+    {
+      if (known && std::equal(value, value + n, cached))
+      {
+        ++elided;
+        return true;
+      }
+      std::copy(value, value + n, cached);
+      known = true;
+      ++issued;
+      return false;
+    }
+
+    // OΏȗ񐔂𐔂 true Ԃ, قȂΖOL^đ񐔂𐔂
+    bool same(GLuint &cached, bool &known, GLuint value)
+    {
+      if (known && cached == value)
+      {
+        ++elided;
+        return true;
+      }
+      cached = value;
+      known = true;
+      ++issued;
+      return false;
+    }
+
+    // I𒆂̃eNX`jbg̃eNX`̃p[^rċL^
+    bool sameEnv(GLenum pname, const GLfloat *value, int n)
+    {
+      unitState *const u(current());
+      if (!u)
+      {
+        ++issued;
+        return false;
+      }
+
+      for (std::vector<envParam>::iterator e = u->env.begin(); e != u->env.end(); ++e)
+      {
+        if (e->pname == pname)
+        {
+          bool known(true);
+          return same(e->value, known, value, n);
+        }
+      }
+
+      envParam e = { pname, { 0.0f, 0.0f, 0.0f, 0.0f } };
+      std::copy(value, value + n, e.value);
+      u->env.push_back(e);
+      ++issued;
+      return false;
+    }
+  };
+
+  // OpenGL ̏Ԃ̃LbV
+  static stateCache state;
+}
+// \endcond
+
+/*!
+** \brief OpenGL ̏Ԃ̃LbV𖳌ɂ.
+*/
+void gg::ggResetState()
+{
+  state.reset();
+}
+
+/*!
+** \brief Ԃ̃LbVg֐̌Ăяo񐔂o.
+**
+**   \param issued OpenGL ɑĂяỏ.
+**   \param elided OƓԂ̂ŏȗĂяỏ.
+**   \param reset true Ȃoɉ񐔂 0 ɂ.
+*/
+void gg::ggGetStateCount(GLuint &issued, GLuint &elided, bool reset)
+{
+  issued = state.issued;
+  elided = state.elided;
+  if (reset) state.issued = state.elided = 0;
+}
+
+/*!
+** \brief Ԃ̃LbVg glActiveTexture() Ăяo.
+**
+**   \param texture eNX`jbg (GL_TEXTURE0 `).
+*/
+void gg::ggActiveTexture(GLenum texture)
+{
+  if (state.active == texture)
+  {
+    ++state.elided;
+    return;
+  }
+  state.active = texture;
+  ++state.issued;
+  glActiveTexture(texture);
+}
+
+/*!
+** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glBindTexture() Ăяo.
+**
+**   \param target eNX`̃^[Qbg.
+**   \param texture eNX`.
+*/
+void gg::ggBindTexture(GLenum target, GLuint texture)
+{
+  unitState *const u(state.current());
+  const GLenum *const t(std::find(stateTargets, stateTargets + stateTargetCount, target));
+  if (u && t != stateTargets + stateTargetCount)
+  {
+    if (state.same(u->texture[t - stateTargets], u->known[t - stateTargets], texture)) return;
+  }
+  else
+  {
+    ++state.issued;
+  }
+  glBindTexture(target, texture);
+}
+
+/*!
+** \brief eNX`폜ďԂ̃LbV菜.
+**
+**   \param n 폜eNX`̐.
+**   \param textures 폜eNX`̔z.
+*/
+void gg::ggDeleteTextures(GLsizei n, const GLuint *textures)
+{
+  // 폜eNX`Ăjbg 0 ԂɂȂ
+  for (GLsizei i = 0; i < n; ++i)
+  {
+    if (textures[i] == 0) continue;
+    for (GLuint u = 0; u < stateUnits; ++u)
+    {
+      for (int t = 0; t < stateTargetCount; ++t)
+      {
+        if (state.unit[u].known[t] && state.unit[u].texture[t] == textures[i]) state.unit[u].texture[t] = 0;
+      }
+    }
+  }
+  glDeleteTextures(n, textures);
+}
+
+/*!
+** \brief Ԃ̃LbVg glUseProgram() Ăяo.
+**
+**   \param program vO.
+*/
+void gg::ggUseProgram(GLuint program)
+{
+  if (!state.same(state.program, state.programKnown, program)) glUseProgram(program);
+}
+
+/*!
+** \brief Ԃ̃LbVg glBindVertexArray() Ăяo.
+**
+**   \param array _zIuWFNg.
+*/
+void gg::ggBindVertexArray(GLuint array)
+{
+  if (!state.same(state.array, state.arrayKnown, array)) glBindVertexArray(array);
+}
+
+/*!
+** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvi(GL_TEXTURE_ENV, ...) Ăяo.
+**
+**   \param pname eNX`̃p[^.
+**   \param param p[^̒l.
+*/
+void gg::ggTexEnvi(GLenum pname, GLint param)
+{
+  const GLfloat value(static_cast<GLfloat>(param));
+  if (!state.sameEnv(pname, &value, 1)) glTexEnvi(GL_TEXTURE_ENV, pname, param);
+}
+
+/*!
+** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvf(GL_TEXTURE_ENV, ...) Ăяo.
+**
+**   \param pname eNX`̃p[^.
+**   \param param p[^̒l.
+*/
+void gg::ggTexEnvf(GLenum pname, GLfloat param)
+{
+  if (!state.sameEnv(pname, &param, 1)) glTexEnvf(GL_TEXTURE_ENV, pname, param);
+}
+
+/*!
+** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvfv(GL_TEXTURE_ENV, ...) Ăяo.
+**
+**   \param pname eNX`̃p[^ (GL_TEXTURE_ENV_COLOR).
+**   \param params p[^̒l (4 vf).
+*/
+void gg::ggTexEnvfv(GLenum pname, const GLfloat *params)
+{
+  if (!state.sameEnv(pname, params, 4)) glTexEnvfv(GL_TEXTURE_ENV, pname, params);
+}
+
+/*!
+** \brief Ԃ̃LbVg glColor4fv() Ăяo.
+**
+**   \param v F (4 vf, nullptr ȂLbV̐Fsɂ).
+*/
+void gg::ggColor4fv(const GLfloat *v)
+{
+  // _z̐Fg݂͌̐F킩Ȃ
+  if (!v)
+  {
+    state.colorKnown = false;
+    return;
+  }
+
+  if (!state.same(state.color, state.colorKnown, v, 4)) glColor4fv(v);
+}
+
+/*!
+** \brief Ԃ̃LbVg glMatrixMode() Ăяo.
+**
+**   \param mode ϊs̎.
+*/
+void gg::ggMatrixMode(GLenum mode)
+{
+  if (state.mode == mode)
+  {
+    ++state.elided;
+    return;
+  }
+  state.mode = mode;
+  ++state.issued;
+  glMatrixMode(mode);
+}
+
+/*!
+** \brief Ԃ̃LbVgđI𒆂̕ϊs glLoadMatrixf() Ăяo.
+**
+**   \param m ϊs (16 vf).
+*/
+void gg::ggLoadMatrixf(const GLfloat *m)
+{
+  // I𒆂̕ϊs̃LbV
+  GLfloat *cached(nullptr);
+  bool *known(nullptr);
+  switch (state.mode)
+  {
+  case GL_MODELVIEW:
+    cached = state.modelview;
+    known = &state.modelviewKnown;
+    break;
+  case GL_PROJECTION:
+    cached = state.projection;
+    known = &state.projectionKnown;
+    break;
+  case GL_TEXTURE:
+    if (unitState *const u = state.current())
+    {
+      cached = u->matrix;
+      known = &u->matrixKnown;
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (cached)
+  {
+    if (state.same(cached, *known, m, 16)) return;
+  }
+  else
+  {
+    ++state.issued;
+  }
+  glLoadMatrixf(m);
+}
+
 /*
 ** ϊsFsƃxNg̐ c  a ~ b
 */
@@ -7315,7 +11490,116 @@ void gg::GgElements::draw(GLint first, GLsizei count) const
 
   // }``悷
   glDrawElements(getMode(), (count > 0 ? count : fnum() - first) * 3,
-    GL_UNSIGNED_INT, static_cast<GLuint (*)[3]>(0) + first);
+    type, static_cast<const GLubyte *>(0) + first * stride());
+}
+
+/*
+** IuWFNgF̃obt@IuWFNgɎOp`̒_CfbNXf[^]
+*/
+void gg::GgElements::send(GLuint nf, const GLuint (*face)[3], GLuint offset)
+{
+  // 32 rbg̃CfbNXȂ炻̂܂ܓ]
+  if (type == GL_UNSIGNED_INT)
+  {
+    index.send(nf * stride(), reinterpret_cast<const GLubyte *>(face), offset * stride());
+    return;
+  }
+
+  // Op` 0 Ȃobt@Ŝɓ]
+  if (nf == 0) nf = fnum();
+  if (nf == 0) return;
+
+  // 16 rbg̃CfbNXɕϊ
+  std::vector<GLushort> temp(nf * 3);
+  for (GLuint i = 0; i < nf; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      // 16 rbgŕ\ȂCfbNXΓ]Ȃ
+      if (face[i][j] > 65535)
+      {
+        std::cerr << "Error: GgElements::send(): index " << face[i][j]
+          << " does not fit in the 16-bit index buffer." << std::endl;
+        return;
+      }
+      temp[i * 3 + j] = static_cast<GLushort>(face[i][j]);
+    }
+  }
+
+  // ϊCfbNX]
+  index.send(nf * stride(), reinterpret_cast<const GLubyte *>(&temp[0]), offset * stride());
+}
+
+/*
+** IuWFNgF̃obt@IuWFNgɎOp` 16 rbg̒_CfbNXf[^]
+*/
+void gg::GgElements::send(GLuint nf, const GLushort (*face)[3], GLuint offset)
+{
+  // 16 rbg̃CfbNXȂ炻̂܂ܓ]
+  if (type == GL_UNSIGNED_SHORT)
+  {
+    index.send(nf * stride(), reinterpret_cast<const GLubyte *>(face), offset * stride());
+    return;
+  }
+
+  // Op` 0 Ȃobt@Ŝɓ]
+  if (nf == 0) nf = fnum();
+  if (nf == 0) return;
+
+  // 32 rbg̃CfbNXɕϊē]
+  std::vector<GLuint> temp(nf * 3);
+  for (GLuint i = 0; i < nf; ++i)
+    for (int j = 0; j < 3; ++j) temp[i * 3 + j] = face[i][j];
+  index.send(nf * stride(), reinterpret_cast<const GLubyte *>(&temp[0]), offset * stride());
+}
+
+/*
+** ʎq_f[^ŕ\Op`FRXgN^
+*/
+gg::GgQuantizedTriangles::GgQuantizedTriangles(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
+  GLuint nf, const GLuint (*face)[3], GLenum type, GLenum mode, GLenum usage)
+  : GgShape(mode), type(type == GL_BYTE ? GL_BYTE : GL_SHORT)
+{
+  // _f[^ʎq (_Ă AABB ݒ肷邽߂ 1 oCg]Ɋmۂ)
+  const size_t size(ggQuantizeVertices(nv, pos, norm, this->type, nullptr, scale, offset));
+  std::vector<GLubyte> data(size + 1);
+  ggQuantizeVertices(nv, pos, norm, this->type, &data[0], scale, offset);
+
+  // ʎq_f[^𒸓_obt@IuWFNgɊi[
+  vertex.load(GL_ARRAY_BUFFER, static_cast<GLuint>(size), &data[0], usage);
+
+  // ʒu index == 0  in ϐɐKē͂
+  const GLsizei stride(this->type == GL_BYTE ? 8 : 12);
+  glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, 0);
+  glEnableVertexAttribArray(0);
+
+  // @ GL ̃o[Wɂ鐳K̈Ⴂ邽ߐ̂܂ index == 1  in ϐɓ͂
+  const GLsizei normal(this->type == GL_BYTE ? 6 : 8);
+  glVertexAttribPointer(1, 2, this->type, GL_FALSE, stride, static_cast<const GLubyte *>(0) + normal);
+  glEnableVertexAttribArray(1);
+
+  // Op`̒_CfbNX
+  if (nf > 0 && face) index.load(GL_ELEMENT_ARRAY_BUFFER, nf, face, usage);
+}
+
+/*
+** ʎq_f[^ŕ\Op`F`
+*/
+void gg::GgQuantizedTriangles::draw(GLint first, GLsizei count) const
+{
+  // _zIuWFNgw肷
+  use();
+
+  // }``悷
+  if (fnum() > 0)
+  {
+    glDrawElements(getMode(), (count > 0 ? count : fnum() - first) * 3,
+      GL_UNSIGNED_INT, static_cast<GLuint (*)[3]>(0) + first);
+  }
+  else
+  {
+    glDrawArrays(getMode(), first, count > 0 ? count : vnum() - first);
+  }
 }
 
 /*!
@@ -7517,6 +11801,16 @@ gg::GgElements *gg::ggElementsObj(const char *name, bool normalize)
   // t@Cǂݍ
   if (!ggLoadObj(name, nv, pos, norm, nf, face, normalize)) return 0;
 
+  // Op`ƒ_̏œK
+  if (objOptimize)
+  {
+    GLuint before, after, unique;
+    countMisses(nf, face, optimizeCache, before, unique);
+    ggOptimizeMesh(nv, pos, norm, nf, face, 0, nullptr, optimizeCache, optimizeThreshold);
+    countMisses(nf, face, optimizeCache, after, unique);
+    reportMisses(name, before, after, unique, nf, optimizeCache);
+  }
+
   // GgElements IuWFNg쐬
   GgElements *const obj(new GgElements(nv, pos, norm, nf, face, GL_TRIANGLES));
 
@@ -7626,9 +11920,23 @@ gg::GgElements *gg::ggElementsMesh(int slices, int stacks, const GLfloat (*pos)[
     }
   }
 
+  // _ƎOp`
+  const GLuint nv((slices + 1) * (stacks + 1));
+  const GLuint nf(static_cast<GLuint>(f.size()) / 3);
+
+  // Op`̏œK (_͕ύXłȂ̂ŕבւȂ)
+  if (objOptimize)
+  {
+    GLuint before, after, unique;
+    GLuint (*const face)[3](reinterpret_cast<GLuint (*)[3]>(&f[0]));
+    countMisses(nf, face, optimizeCache, before, unique);
+    optimizeTriangles(nv, pos, nf, face, 0, nullptr, optimizeCache, optimizeThreshold);
+    countMisses(nf, face, optimizeCache, after, unique);
+    reportMisses("mesh", before, after, unique, nf, optimizeCache);
+  }
+
   // GgElements IuWFNg쐬
-  return new GgElements((slices + 1) * (stacks + 1), pos, norm,
-    static_cast<GLuint>(f.size()) / 3, reinterpret_cast<GLuint (*)[3]>(&f[0]), GL_TRIANGLES);
+  return new GgElements(nv, pos, norm, nf, reinterpret_cast<GLuint (*)[3]>(&f[0]), GL_TRIANGLES);
 }
 
 /*!
@@ -7719,12 +12027,54 @@ gg::GgObj::~GgObj()
 /*
 ** Wavefront OBJ `̃f[^FRXgN^
 */
-gg::GgObj::GgObj(const char *name, bool normalize)
+gg::GgObj::GgObj(const char *name, bool normalize, bool indexed)
   : data(nullptr), shader(nullptr)
 {
   GLuint nv;
   GLfloat (*pos)[3], (*norm)[3];
 
+  if (indexed)
+  {
+    GLuint nf;
+    GLuint (*face)[3];
+
+    // t@Cd̂Ȃ_ƃCfbNXœǂݍ
+    if (ggLoadObj(name, ng, group, amb, diff, spec, shi, nv, pos, norm, nf, face, normalize))
+    {
+      // ʃO[ṽCfbNX͈̔͂Op`͈̔͂ɂ
+      for (GLuint g = 0; g < ng; ++g)
+      {
+        group[g][0] /= 3;
+        group[g][1] /= 3;
+      }
+
+      // _ 65536 ȉȂ 16 rbg̃CfbNXɂ
+      GLushort (*const sface)[3](nv <= 65536 ? new(std::nothrow) GLushort[nf][3] : nullptr);
+      if (sface)
+      {
+        for (GLuint f = 0; f < nf; ++f)
+        {
+          sface[f][0] = static_cast<GLushort>(face[f][0]);
+          sface[f][1] = static_cast<GLushort>(face[f][1]);
+          sface[f][2] = static_cast<GLushort>(face[f][2]);
+        }
+        data = new GgElements(nv, pos, norm, nf, sface);
+        delete[] sface;
+      }
+      else
+      {
+        data = new GgElements(nv, pos, norm, nf, face);
+      }
+
+      // ƗpɊmۂ
+      delete[] pos;
+      delete[] norm;
+      delete[] face;
+    }
+
+    return;
+  }
+
   // t@Cǂݍ
   if (ggLoadObj(name, ng, group, amb, diff, spec, shi, nv, pos, norm, normalize))
   {
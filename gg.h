@@ -2522,6 +2522,11 @@ extern PFNGLWRITEMASKEXTPROC glWriteMaskEXT;
 #  error "This platform is not supported."
 #endif
 
+// S3TC ̃eNX`k``ĂȂΒ`
+#if !defined(GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+#  define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
 namespace gg
 {
   /*!
@@ -2588,6 +2593,39 @@ namespace gg
   */
   extern GLubyte *ggLoadTga(const char *name, GLsizei *width, GLsizei *height, GLenum *format);
 
+  /*!
+  ** \brief TGA t@C (8/16/24/32bit) ̃wb_ǂݍ.
+  **
+  **   \param name ǂݍރt@C.
+  **   \param width ǂݍ񂾃t@C̉̉f.
+  **   \param height ǂݍ񂾃t@C̏c̉f.
+  **   \param format ǂݍ񂾃t@C̏. GL_RED, G_RG, GL_BGR, G_BGRA.
+  **   \return ǂݍ݂ɐ true, s false.
+  */
+  extern bool ggLoadTgaHeader(const char *name, GLsizei *width, GLsizei *height, GLenum *format);
+
+  /*!
+  ** \brief TGA t@C (8/16/24/32bit) ̋`̈悾ɓǂݍ.
+  **
+  **   t@C擪sǂݐi, ؂o`̈̉fl߂Ċi[.
+  **   񈳏k̃t@C͕KvȍsV[Nēǂ, RLE k̃t@C͋`̈̍Ō̍s܂œWJ.
+  **   k̑傫w肷Ɠǂݍ݂Ȃʐϕςŏk̂,
+  **   gp郁̓t@CŜł͂Ȃ؂ö̑傫Ō܂.
+  **   f̕т ggLoadTga() Ɠ, W̓t@CɊi[Ă鏇̉fʒuŎw肷.
+  **
+  **   \param name ǂݍރt@C.
+  **   \param x ؂o`̈̍[̉fʒu.
+  **   \param y ؂o`̈̍ŏ̍s̉fʒu.
+  **   \param w ؂o`̈̕.
+  **   \param h ؂o`̈̍.
+  **   \param dw k̕ (0 ȂkȂ, w 傫 w).
+  **   \param dh k̍ (0 ȂkȂ, h 傫 h).
+  **   \param format ǂݍ񂾃t@C̏. GL_RED, G_RG, GL_BGR, G_BGRA.
+  **   \return ǂݍ݂ɐ dw ~ dh f̉摜f[^̃|C^, s nullptr.
+  */
+  extern GLubyte *ggLoadTgaCrop(const char *name, GLsizei x, GLsizei y, GLsizei w, GLsizei h,
+    GLsizei dw, GLsizei dh, GLenum *format);
+
   /*!
   ** \brief eNX`mۂĉ摜f[^eNX`Ƃēǂݍ.
   **
@@ -2619,6 +2657,97 @@ namespace gg
   */
   extern GLuint ggLoadHeight(const char *name, float nz, GLenum internal = GL_RGBA);
 
+  /*!
+  ** \brief 摜 BC1 (DXT1) `Ɉk.
+  **
+  **   4x4 f̃ubNƂ 2 F̑\F 2 bit ̃CfbNXɈk.
+  **   ubN̍s𕡐̃Xbhɕĕɏ.
+  **
+  **   \param image k摜f[^.
+  **   \param width 摜̕.
+  **   \param height 摜̍.
+  **   \param format 摜f[^̏. GL_RGB, GL_BGR, GL_RGBA, GL_BGRA (At@͖).
+  **   \param data kf[^̊i[ (nullptr ȂKvȃoCg߂邾).
+  **   \param threads gpXbh (0 Ȃn[hEFÃXbh).
+  **   \return kf[^̃oCg.
+  */
+  extern size_t ggCompressBC1(const GLubyte *image, GLsizei width, GLsizei height, GLenum format,
+    GLubyte *data, unsigned int threads = 0);
+
+  /*!
+  ** \brief Px_̔z𔼐x_ɕϊ.
+  **
+  **   ł߂lɊۂ, \łȂ傫̒l͖ɂ.
+  **
+  **   \param src ϊPx_̔z.
+  **   \param count ϊvf.
+  **   \param dst ϊx_̊i[.
+  */
+  extern void ggFloatToHalf(const GLfloat *src, size_t count, GLhalf *dst);
+
+  /*!
+  ** \brief _̈ʒuƖ@ʎqċl߂_f[^.
+  **
+  **   ʒu AABB ɑ΂ 16 rbg̕ȂK 3 ɂ, @͔ʑ̎ʑ
+  **   t 2 ɂ. 1 _͖@ 16 rbgȂ 12 oCg (ʒu 6, \ 2, @ 4),
+  **   8 rbgȂ 8 oCg (ʒu 6, @ 2) , GLfloat[3] ̈ʒuƖ@ 24 oCg̔ 1/3 ɂȂ.
+  **   ʒǔ덷 AABB ̊eӂ̒ 1/131070 x, @̊px̌덷 16 rbg 0.05 x,
+  **   8 rbg 0.7 xxȉɂȂ. ɂ ggQuantizedDecoder g.
+  **
+  **   \param nv _.
+  **   \param pos _̈ʒu.
+  **   \param norm _̖@ (PʃxNg).
+  **   \param type @̐̃f[^^ (GL_SHORT  GL_BYTE).
+  **   \param data ʎq_f[^̊i[ (nullptr ȂKvȃoCg߂邾).
+  **   \param scale ʒu̕Ɏg AABB ̑傫̊i[ (3 vf).
+  **   \param offset ʒu̕Ɏg AABB ̍ŏl̊i[ (3 vf).
+  **   \return ʎq_f[^̃oCg.
+  */
+  extern size_t ggQuantizeVertices(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3], GLenum type,
+    GLubyte *data, GLfloat *scale, GLfloat *offset);
+
+  /*!
+  ** \brief ʎq_f[^𕜍 GLSL ̊֐̃\[XvO.
+  **
+  **   o[ebNXVF[_ main() ̑Oɑ}, ʒu (index == 0) 
+  **   ggDecodePosition(), @ (index == 1)  ggDecodeNormal() ŕ.
+  **   uniform ϐ qscale, qoffset, qrange  GgQuantizedTriangles::setDecoder() Őݒ肷.
+  */
+  extern const char *const ggQuantizedDecoder;
+
+  /*!
+  ** \brief OBJ t@C̓ǂݍ݂ɎgXbhݒ肷.
+  **
+  **   ggLoadObj() ̓t@Cs̋؂ŕ, e̗vf̗ݐϘai[߂ĕɉ͂.
+  **   ʂ̓Xbhɂ炸 1 Xbhœǂݍ񂾂ƂƓɂȂ.
+  **
+  **   \param threads gpXbh (0 Ȃn[hEFÃXbh, ȃt@C͕Ȃ).
+  */
+  extern void ggObjThreads(unsigned int threads);
+
+  /*!
+  ** \brief OBJ t@C̃bVLbVgǂݒ肷.
+  **
+  **   }eAt ggLoadObj() ( GgObj, ggArraysObj()) ͓ǂݍ񂾌ʂ
+  **   OBJ t@C .ggm tt@Cɕۑ,  OBJ t@C MTL t@C
+  **   XVƃoCgۑƂƓȂ, Ƀ}bvĉ͂ɓǂݍ.
+  **   ef[^̐擪 64 oCgEɂ낦Ă, _ʒu͐KO̒lŕۑ.
+  **
+  **   \param cache true Ȃ烁bVLbVg (l true).
+  */
+  extern void ggObjCache(bool cache);
+
+  /*!
+  ** \brief OBJ t@CǂݍނƂɃ}eA̒`Ɛ؂ւ\邩ǂݒ肷.
+  **
+  **   }eAt ggLoadObj()  MTL t@C newmtl  OBJ t@C usemtl WG[o͂ɕ\.
+  **   }eApɂɐ؂ւt@Cł͕\ɎԂ̂, ʏ͕\Ȃ.
+  **   `̃}eAJȂ MTL t@Čx͏ɕ\.
+  **
+  **   \param verbose true Ȃ\ (l false).
+  */
+  extern void ggObjVerbose(bool verbose);
+
   /*!
   ** \brief Op`ꂽ OBJ t@Cǂݍ (Elements `).
   **
@@ -2636,6 +2765,9 @@ namespace gg
   /*!
   ** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍ (Arrays `)
   **
+  **   ʂ͓}eAƂɂ܂Ƃ, }eAŏɌꂽɈ̖ʃO[vɂ.
+  **   }eA̖ʂ̏̓t@C̏̂܂܂ɂ.
+  **
   **   \param name ǂݍ Wavefront OBJ t@C.
   **   \param ng ǂݍ񂾃f[^̖ʃO[v.
   **   \param group ǂݍ񂾃f[^̖ʃO[v̍ŏ̖ʂ̃CfbNXƖʐ.
@@ -2653,6 +2785,134 @@ namespace gg
     GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
     GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3], bool normalize = false);
 
+  /*!
+  ** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍ (Elements `)
+  **
+  **   Arrays `œǂݍ񂾎Op`̒_̂ʒuƖ@̂nbV\ňɂ܂Ƃ,
+  **   d̂Ȃ_f[^ƎOp`̒_CfbNX. Op`̏ Arrays `ƓȂ̂,
+  **   ʃO[v̓CfbNX͈̔ (ŏ̃CfbNX̔ԍƃCfbNX̐) ɂȂ.
+  **
+  **   \param name ǂݍ Wavefront OBJ t@C.
+  **   \param ng ǂݍ񂾃f[^̖ʃO[v.
+  **   \param group ǂݍ񂾃f[^̖ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+  **   \param amb ǂݍ񂾃f[^̖ʃO[vƂ̊ɑ΂锽ˌW.
+  **   \param diff ǂݍ񂾃f[^̖ʃO[vƂ̊gUˌW.
+  **   \param spec ǂݍ񂾃f[^̖ʃO[vƂ̋ʔˌW.
+  **   \param shi ǂݍ񂾃f[^̖ʃO[vƂ̋PW.
+  **   \param nv ǂݍ񂾃f[^̏d̂Ȃ_.
+  **   \param pos ǂݍ񂾃f[^̒_W.
+  **   \param norm ǂݍ񂾃f[^̒_@.
+  **   \param nf ǂݍ񂾃f[^̎Op`.
+  **   \param face ǂݍ񂾃f[^̎Op`̒_CfbNX.
+  **   \param normalize true Ȃǂݍ񂾃f[^̑傫𐳋K.
+  **   \return t@C̓ǂݍ݂ɐ true.
+  */
+  extern bool ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
+    GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+    GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
+    GLuint &nf, GLuint (*&face)[3], bool normalize = false);
+
+  /*!
+  ** \brief Op`ꂽ OBJ t@C MTL t@Cǂݍŏڍדx (LOD) ̒iK (Elements `)
+  **
+  **   Elements `œǂݍ񂾌` ggSimplifyMesh() ŎOp`𔼕炵čő 8 iKɂ.
+  **   iK l ̖ʃO[v g  face ̃CfbNX group[l * ng + g][0]  group[l * ng + g][1] ,
+  **   ׂĂ̒iKœ_̔zg. 쐬iK OBJ t@C .ggl tbVLbVɕۑ.
+  **
+  **   \param name OBJ t@C.
+  **   \param ng ǂݍ񂾃f[^̖ʂ̃O[v.
+  **   \param group iKƂ̖ʂ̊eO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+  **   \param amb O[vƂ̊ɑ΂锽ˌW.
+  **   \param diff O[vƂ̊gUˌW.
+  **   \param spec O[vƂ̋ʔˌW.
+  **   \param shi O[vƂ̋PW.
+  **   \param nv d̂Ȃ_i[ϐ.
+  **   \param pos _̈ʒũf[^i[̃|C^i[ϐ.
+  **   \param norm _̖@f[^̊i[̃|C^i[ϐ.
+  **   \param nl ڍדx̒iKi[ϐ.
+  **   \param error iKƂ̈ʒǔ덷i[̃|C^i[ϐ.
+  **   \param nf ׂĂ̒iK̎Op`̍vi[ϐ.
+  **   \param face ׂĂ̒iK̎Op`̒_CfbNXi[̃|C^i[ϐ.
+  **   \param normalize true ȂTCY𐳋K.
+  **   \return ǂݍ݂ɐ true.
+  */
+  extern bool ggLoadObj(const char *name, GLuint &ng, GLuint (*&group)[2],
+    GLfloat (*&amb)[4], GLfloat (*&diff)[4], GLfloat (*&spec)[4], GLfloat *&shi,
+    GLuint &nv, GLfloat (*&pos)[3], GLfloat (*&norm)[3],
+    GLuint &nl, GLfloat *&error, GLuint &nf, GLuint (*&face)[3], bool normalize = false);
+
+  /*!
+  ** \brief ǂݍ񂾌`쐬`œK邩ǂݒ肷.
+  **
+  **   true ɂ Elements ` ggLoadObj() ( CfbNXg GgObj),
+  **   ggElementsObj(), ggElementsMesh()  ggOptimizeMesh() gĎOp`בւ,
+  **   ̑O ACMR  ATVR \. Elements ` ggLoadObj() ͍œKʂ
+  **   OBJ t@C .ggi tbVLbVɕۑ̂, œK͈xs΂悢.
+  **
+  **   \param optimize true ȂœK (l false).
+  */
+  extern void ggMeshOptimize(bool optimize);
+
+  /*!
+  ** \brief _LbV̌߂.
+  **
+  **   \param nf Op`.
+  **   \param face Op`̒_CfbNX.
+  **   \param cache _LbV (FIFO) ̑傫.
+  **   \param acmr Op`̃LbV~X̐ (ACMR, 0.5`3) i[ϐ.
+  **   \param atvr gꂽ_̃LbV~X̐ (ATVR, 1 ȏ) i[ϐ.
+  */
+  extern void ggMeshStats(GLuint nf, const GLuint (*face)[3], GLuint cache, GLfloat &acmr, GLfloat &atvr);
+
+  /*!
+  ** \brief Op`ƒ_̏œK.
+  **
+  **   ʃO[vƂɎOp` Tipsify Œ_LbVɍ킹ĕבւ, s~܂肩
+  **   LbV~X̊\ȂȂƂŃNX^ɕ, ONX^قǐɕ`悤
+  **   גďdȂ炷. Ōɒ_ŏɎg鏇ɕבւĒ_̓ǂݏo܂Ƃ߂.
+  **
+  **   \param nv _.
+  **   \param pos _̈ʒu.
+  **   \param norm _̖@ (nullptr ȂבւȂ).
+  **   \param nf Op`.
+  **   \param face Op`̒_CfbNX.
+  **   \param ng ʃO[v (0 ȂŜ̖ʃO[vɂ).
+  **   \param group ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+  **   \param cache _LbV (FIFO) ̑傫.
+  **   \param threshold NX^ɕ ACMR ̂l (בւ ACMR ɑ΂, 1 ɋ߂قǃLbV̌D悷).
+  */
+  extern void ggOptimizeMesh(GLuint nv, GLfloat (*pos)[3], GLfloat (*norm)[3], GLuint nf, GLuint (*face)[3],
+    GLuint ng = 0, const GLuint (*group)[2] = nullptr, GLuint cache = 16, GLfloat threshold = 1.05f);
+
+  /*!
+  ** \brief 񎟌덷ɂӂ̏kŏڍדx (LOD) ̒iK.
+  **
+  **   _אڒ_Ɉڂk덷̏ɍs, Op`iKƂ ratio {Ɍ炵Ă.
+  **   _͈ڂŐVɍȂ̂, ׂĂ̒iKŌ̒_̔ẑ܂܎g.
+  **   ʃO[v̋E, @̕sAȌp, J̒_͓Ȃ̂, ʃO[v̍ގ̋ڂ͕ۂ.
+  **   iK l ̖ʃO[v g  lface ̃CfbNX lgroup[l * ng + g][0]  lgroup[l * ng + g][1] ɂȂ.
+  **   lerror[l] ͒iK l ̌`ƌ̌`Ƃ̖̋ڈ, eƂ̑傫iKIԂ̂Ɏg.
+  **   lface, lgroup, lerror ͎gp delete[] ŉ.
+  **
+  **   \param nv _.
+  **   \param pos _̈ʒu.
+  **   \param nf Op`.
+  **   \param face Op`̒_CfbNX.
+  **   \param ng ʃO[v (0 ȂŜ̖ʃO[vɂ).
+  **   \param group ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐.
+  **   \param levels 쐬iK̏ (̌`܂).
+  **   \param ratio iKƂɎcOp`̊.
+  **   \param nl 쐬iKi[ϐ.
+  **   \param lnf ׂĂ̒iK̎Op`̍vi[ϐ.
+  **   \param lface ׂĂ̒iK̎Op`̒_CfbNXi[̃|C^i[ϐ.
+  **   \param lgroup iKƂ̖ʃO[v̍ŏ̃CfbNX̔ԍƃCfbNX̐i[̃|C^i[ϐ.
+  **   \param lerror iKƂ̈ʒǔ덷i[̃|C^i[ϐ.
+  **   \return 쐬ɐ true.
+  */
+  extern bool ggSimplifyMesh(GLuint nv, const GLfloat (*pos)[3], GLuint nf, const GLuint (*face)[3],
+    GLuint ng, const GLuint (*group)[2], GLuint levels, GLfloat ratio,
+    GLuint &nl, GLuint &lnf, GLuint (*&lface)[3], GLuint (*&lgroup)[2], GLfloat *&lerror);
+
   /*!
   ** \brief VF[_̃\[XvO̕ǂݍŃvOIuWFNg쐬.
   **
@@ -2685,6 +2945,116 @@ namespace gg
   extern GLuint ggLoadShader(const char *vert, const char *frag = nullptr, const char *geom = nullptr,
     int nvarying = 0, const char *varyings[] = nullptr);
 
+  /*!
+  ** \brief OpenGL ̏Ԃ̃LbV𖳌ɂ.
+  **
+  **   ggActiveTexture() Ȃǂ̏Ԃ̃LbVg֐, Oɐݒ肵lƓl̐ݒ
+  **   OpenGL ɑ炸ɏȗ. ̊֐g킸 glBindTexture() ȂǂŒڏԂύXƂ,
+  **   ̊֐ĂŃLbV𖳌ɂĂ (̐ݒ͕K OpenGL ɑ܂).
+  **   LbV͈ OpenGL ̃ReLXgŎgƂz肵Ă.
+  */
+  extern void ggResetState();
+
+  /*!
+  ** \brief Ԃ̃LbVg֐̌Ăяo񐔂o.
+  **
+  **   \param issued OpenGL ɑĂяỏ.
+  **   \param elided OƓԂ̂ŏȗĂяỏ.
+  **   \param reset true Ȃoɉ񐔂 0 ɂ (t[Ƃ̉񐔂𓾂ƂɎg).
+  */
+  extern void ggGetStateCount(GLuint &issued, GLuint &elided, bool reset = true);
+
+  /*!
+  ** \brief Ԃ̃LbVg glActiveTexture() Ăяo.
+  **
+  **   \param texture eNX`jbg (GL_TEXTURE0 `).
+  */
+  extern void ggActiveTexture(GLenum texture);
+
+  /*!
+  ** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glBindTexture() Ăяo.
+  **
+  **   GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_CUBE_MAP ȊÕ^[Qbg͏ȗȂ.
+  **
+  **   \param target eNX`̃^[Qbg.
+  **   \param texture eNX`.
+  */
+  extern void ggBindTexture(GLenum target, GLuint texture);
+
+  /*!
+  ** \brief eNX`폜ďԂ̃LbV菜.
+  **
+  **   폜eNX`ĂeNX`jbg 0 ԂɂȂ.
+  **
+  **   \param n 폜eNX`̐.
+  **   \param textures 폜eNX`̔z.
+  */
+  extern void ggDeleteTextures(GLsizei n, const GLuint *textures);
+
+  /*!
+  ** \brief Ԃ̃LbVg glUseProgram() Ăяo.
+  **
+  **   \param program vO.
+  */
+  extern void ggUseProgram(GLuint program);
+
+  /*!
+  ** \brief Ԃ̃LbVg glBindVertexArray() Ăяo.
+  **
+  **   \param array _zIuWFNg.
+  */
+  extern void ggBindVertexArray(GLuint array);
+
+  /*!
+  ** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvi(GL_TEXTURE_ENV, ...) Ăяo.
+  **
+  **   \param pname eNX`̃p[^ (GL_TEXTURE_ENV_MODE, GL_COMBINE_RGB Ȃ).
+  **   \param param p[^̒l.
+  */
+  extern void ggTexEnvi(GLenum pname, GLint param);
+
+  /*!
+  ** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvf(GL_TEXTURE_ENV, ...) Ăяo.
+  **
+  **   \param pname eNX`̃p[^ (GL_RGB_SCALE Ȃ).
+  **   \param param p[^̒l.
+  */
+  extern void ggTexEnvf(GLenum pname, GLfloat param);
+
+  /*!
+  ** \brief Ԃ̃LbVgđI𒆂̃eNX`jbg glTexEnvfv(GL_TEXTURE_ENV, ...) Ăяo.
+  **
+  **   \param pname eNX`̃p[^ (GL_TEXTURE_ENV_COLOR).
+  **   \param params p[^̒l (4 vf).
+  */
+  extern void ggTexEnvfv(GLenum pname, const GLfloat *params);
+
+  /*!
+  ** \brief Ԃ̃LbVg glColor4fv() Ăяo.
+  **
+  **   _zɐF܂ތ``݂͌̐FsɂȂ̂, nullptr n
+  **   LbV̐FsɂĂ.
+  **
+  **   \param v F (4 vf, nullptr Ȃ OpenGL ɂ͑炸LbV̐Fsɂ).
+  */
+  extern void ggColor4fv(const GLfloat *v);
+
+  /*!
+  ** \brief Ԃ̃LbVg glMatrixMode() Ăяo.
+  **
+  **   \param mode ϊs̎ (GL_MODELVIEW, GL_PROJECTION, GL_TEXTURE).
+  */
+  extern void ggMatrixMode(GLenum mode);
+
+  /*!
+  ** \brief Ԃ̃LbVgđI𒆂̕ϊs glLoadMatrixf() Ăяo.
+  **
+  **   GL_TEXTURE ̕ϊs̓eNX`jbgƂɋL^.
+  **
+  **   \param m ϊs (16 vf).
+  */
+  extern void ggLoadMatrixf(const GLfloat *m);
+
   /*!
   ** \brief NX.
   */
@@ -4539,6 +4909,401 @@ namespace gg
     }
   };
 
+  /*!
+  ** \brief 񓯊t[Lv`.
+  **
+  **   J[obt@܂̓fvXobt@̓e𕡐̃sNZobt@IuWFNg
+  **   Ԃɓǂݏo, t[Ƀ}bvăobNOEh̃Xbh TGA t@Cɕۑ.
+  **   ggSaveColor() / ggSaveDepth() ƈقȂ glFinish() ŕ`̊҂Ȃ.
+  */
+  class GgCapture
+    : public Gg
+  {
+    // sNZobt@IuWFNg̍ő吔
+    static const unsigned int maxBuffers = 8;
+
+    // ǂݏoɎgsNZobt@IuWFNg̐
+    const unsigned int count;
+
+    // ǂݏoobt@̏ (GL_RGB ܂ GL_DEPTH_COMPONENT)
+    const GLenum format;
+
+    // 1 f̃oCg
+    const unsigned int depth;
+
+    // sNZobt@IuWFNg
+    GLuint pbo[maxBuffers];
+
+    // sNZobt@IuWFNgɊmۂTCY
+    GLsizeiptr capacity[maxBuffers];
+
+    // ǂݏo̊o铯IuWFNg
+    GLsync fence[maxBuffers];
+
+    // ǂݏo摜̕ƍ
+    GLsizei width[maxBuffers], height[maxBuffers];
+
+    // ۑt@C
+    char *filename[maxBuffers];
+
+    // ɓǂݏoɎgsNZobt@IuWFNg̔ԍ
+    unsigned int head;
+
+    // ǂݏõsNZobt@IuWFNg̐
+    unsigned int used;
+
+    // t@C݂̏sXbh
+    struct Writer;
+    Writer *const writer;
+
+    // ǂݏosNZobt@IuWFNg̓e݃Xbhɓn
+    void retrieve(unsigned int slot);
+
+    // Rs[͋֎~
+    GgCapture(const GgCapture &o);
+    GgCapture &operator=(const GgCapture &o);
+
+  public:
+
+    //! \brief fXgN^.
+    //!   \brief ǂݏõt[ׂĕۑĂ珑݃XbhI.
+    virtual ~GgCapture();
+
+    //! \brief RXgN^.
+    //!   \param format ǂݏoobt@. GL_RGB ȂJ[obt@, GL_DEPTH_COMPONENT ȂfvXobt@.
+    //!   \param buffers ǂݏoɎgsNZobt@IuWFNg̐ (2`8).
+    //!   \param queue ݃Xbhɕێt[̏ (𒴂Ə݂҂).
+    GgCapture(GLenum format = GL_RGB, unsigned int buffers = 3, unsigned int queue = 16);
+
+    //! \brief ݂̃r[|[g̓e̓ǂݏoJn.
+    //!   \brief ǂݏoe͐t[ TGA t@Cɕۑ.
+    //!   \param name ۑt@C.
+    void capture(const char *name);
+
+    //! \brief ǂݏõt[ׂď݃Xbhɓn, t@C̕ۑ̊҂.
+    void flush();
+
+    //! \brief ۑĂȂt[𓾂.
+    //!   \return ǂݏo܂͏ݑ҂̃t[.
+    unsigned int pending() const;
+  };
+
+  /*!
+  ** \brief t[̋ԂƂ CPU Ԃ GPU Ԃ̌v.
+  **
+  **   OtԂ̊JnƏI CPU ̎ (steady_clock)  GPU ̎ (GL_TIMESTAMP ̃NG) L^.
+  **   GPU ̎͐t[ɓǂݏôŕ`~߂Ȃ. Ԃ͓qɂĂ悢.
+  **   ԂƂɒ߂̃t[̌vlێ, ŏl, ϒl, p50, p90, p99 Ȃǂ\Eۑ.
+  */
+  class GgProfiler
+    : public Gg
+  {
+    // GPU ̎̓ǂݏo҂t[
+    static const unsigned int latency = 4;
+
+    // ԂƂ̌vl
+    struct Scopes;
+    Scopes *const scopes;
+
+    // t[OɔsNǦʂǂݏo
+    void retrieve(unsigned int slot);
+
+    // Rs[͋֎~
+    GgProfiler(const GgProfiler &o);
+    GgProfiler &operator=(const GgProfiler &o);
+
+  public:
+
+    //! \brief fXgN^.
+    virtual ~GgProfiler();
+
+    //! \brief RXgN^.
+    //!   \param samples v钼߂̃t[.
+    GgProfiler(unsigned int samples = 600);
+
+    //! \brief t[̌vJn.
+    //!   \brief t[̍ŏɌĂяo. t[O GPU ̎œǂݏo.
+    void frame();
+
+    //! \brief Ԃ̌vJn.
+    //!   \brief ̃t[œŐԂxvƂ, GPU Ԃ͍Ō̂̂g.
+    //!   \param name Ԃ̖O.
+    void begin(const char *name);
+
+    //! \brief ŌɊJnԂ̌vI.
+    void end();
+
+    //! \brief sNǦʂׂēǂݏo (GPU ̏̊҂).
+    void flush();
+
+    //! \brief vl.
+    void reset();
+
+    //! \brief Ԃ̒߂ GPU Ԃo.
+    //!   \brief GPU ̎͐t[xēǂݏô, latency t[ǑvlɂȂ.
+    //!   \param name Ԃ̖O.
+    //!   \return GPU  (~b), ܂vlȂΕ̒l.
+    double getGpuTime(const char *name) const;
+
+    //! \brief t[Ƃ̒lL^.
+    //!   \brief `̏kȂǂ̎ԈȊO̒lԂƈꏏɓv.
+    //!   \param name l̖O.
+    //!   \param value L^l.
+    void record(const char *name, double value);
+
+    //! \brief ԂƂ CPU Ԃ GPU Ԃ̓v\.
+    //!   \brief sNǦʂׂēǂݏoĂ\. L^l΂̓v\.
+    void report();
+
+    //! \brief ԂƂ CPU Ԃ GPU Ԃ̓v CSV t@Cɕۑ.
+    //!   \brief L^l, ̓vsɑĕʂ̕\Ƃĕۑ.
+    //!   \param name ۑt@C.
+    //!   \return ۑɐ true.
+    bool save(const char *name);
+  };
+
+  /*!
+  ** \brief ̂ AABB ̊Kw (BVH) ɂ鎋JO.
+  **
+  **   ̂Ƃ AABB ̒S̕złL̒lōċAIɓ񕪂Kw,
+  **    6 ̕ʂƂ̔ SIMD ߂ 4 ʂs.
+  **   ߓ_ AABB ɊSɊ܂܂Ă, ͔̉̂̕肹ɉƂ.
+  */
+  class GgBvh
+    : public Gg
+  {
+    // ߓ_
+    struct Node
+    {
+      GLfloat center[3];  // AABB ̒S
+      GLfloat extent[3];  // AABB ̒Seʂ܂ł̋
+      GLuint right;       // ߓ_ȂE̎q̐ߓ_̔ԍ (̎q͎̐ߓ_), tȂ 0
+      GLuint first;       // ؂̂̔̕ԍ object ̈ʒu
+      GLuint count;       // ؂̂̐̕
+    };
+
+    // ߓ_ ([D̏ɕׂ)
+    Node *node;
+
+    // ߓ_̐
+    GLuint nodes;
+
+    // ̂̔ԍ (t̏ɕׂ̂ŕ؂̂̕͘A)
+    GLuint *object;
+
+    // ̂̐
+    GLuint objects;
+
+    // first Ԗڂ count ̂̕̕؂, ̍̐ߓ_̔ԍԂ
+    GLuint subdivide(GLuint first, GLuint count, const GLfloat (*bmin)[3], const GLfloat (*bmax)[3]);
+
+    // Rs[͋֎~
+    GgBvh(const GgBvh &o);
+    GgBvh &operator=(const GgBvh &o);
+
+  public:
+
+    //! \brief fXgN^.
+    virtual ~GgBvh();
+
+    //! \brief RXgN^.
+    GgBvh();
+
+    //! \brief ̂ AABB Kw.
+    //!   \param count ̂̐.
+    //!   \param bmin ̂Ƃ AABB ̍ŏl.
+    //!   \param bmax ̂Ƃ AABB ̍ől.
+    void build(GLuint count, const GLfloat (*bmin)[3], const GLfloat (*bmax)[3]);
+
+    //! \brief ƌ镨̂I.
+    //!   \param mc AABB ̍WnNbsOWnւ̕ϊs (eϊs ~ fr[ϊs).
+    //!   \param visible ƌ镨̂̔ԍ̊i[ (̗̂̐vfKv).
+    //!   \return ƌ镨̂̐.
+    GLuint cull(const GgMatrix &mc, GLuint *visible) const;
+
+    //! \brief ̂̐𓾂.
+    //!   \return build() ɓn̂̐.
+    GLuint count() const
+    {
+      return objects;
+    }
+  };
+
+  /*!
+  ** \brief Ƀ}bvt@C.
+  **
+  **   t@C̓eǂݍ܂ɂ̂܂܃AhXԂɊ蓖Ă.
+  */
+  class GgMappedFile
+    : public Gg
+  {
+    // }bvt@C̐擪̃AhX
+    const GLubyte *address;
+
+    // }bvt@C̃oCg
+    size_t length;
+
+#if defined(_WIN32)
+    // t@C̃nh
+    void *file;
+
+    // t@C}bsOIuWFNg̃nh
+    void *mapping;
+#endif
+
+    // Rs[͋֎~
+    GgMappedFile(const GgMappedFile &o);
+    GgMappedFile &operator=(const GgMappedFile &o);
+
+  public:
+
+    //! \brief fXgN^.
+    virtual ~GgMappedFile()
+    {
+      close();
+    }
+
+    //! \brief RXgN^.
+    //!   \param name }bvt@C (nullptr Ȃ}bvȂ).
+    GgMappedFile(const char *name = nullptr);
+
+    //! \brief t@C}bv.
+    //!   \param name }bvt@C.
+    //!   \return }bvɐ true.
+    bool open(const char *name);
+
+    //! \brief t@C̃}bv.
+    void close();
+
+    //! \brief }bvt@C̐擪̃AhX𓾂.
+    //!   \return }bvt@C̐擪̃AhX (}bvĂȂ nullptr).
+    const GLubyte *data() const
+    {
+      return address;
+    }
+
+    //! \brief }bvt@C̃oCg𓾂.
+    //!   \return }bvt@C̃oCg.
+    size_t size() const
+    {
+      return length;
+    }
+  };
+
+  /*!
+  ** \brief }bvoht@C̃wb_.
+  **
+  **   }bvoh̓wb_, ڎ (GgBundleEntry ̔z), E낦摜f[^̏ɕ.
+  */
+  struct GgBundleHeader
+  {
+    char magic[4];                          //!< ʎq "GGMB".
+    GLuint version;                         //!< ̃o[W.
+    GLuint count;                           //!< i[Ă摜̐.
+    GLuint alignment;                       //!< 摜f[^̐擪̃oCgE.
+  };
+
+  /*!
+  ** \brief }bvoht@C̖ڎ̍.
+  */
+  struct GgBundleEntry
+  {
+    char name[32];                          //!< ̃t@C.
+    GLuint width;                           //!< 摜̕.
+    GLuint height;                          //!< 摜̍.
+    GLenum internal;                        //!< eNX`̓tH[}bg.
+    GLenum format;                          //!< 摜f[^̏ (kf[^Ȃ 0).
+    GLenum type;                            //!< 摜f[^̃f[^^ (kf[^Ȃ 0).
+    GLuint reserved;                        //!< \.
+    GLfloat border[4];                      //!< eNX`̋EF.
+    GLuint64 offset;                        //!< t@C̐擪摜f[^܂ł̃oCg.
+    GLuint64 size;                          //!< 摜f[^̃oCg.
+  };
+
+  /*!
+  ** \brief ̉摜̃}bvoht@Cɕۑ.
+  **
+  **   \param name ۑt@C.
+  **   \param count ۑ摜̐.
+  **   \param entry ۑ摜̖ڎ̍ڂ̔z (offset ͖).
+  **   \param data ۑ摜f[^̃|C^̔z.
+  **   \param alignment 摜f[^̐擪̃oCgE.
+  **   \return ۑɐ true, s false.
+  */
+  extern bool ggSaveBundle(const char *name, GLuint count, const GgBundleEntry *entry,
+    const GLvoid *const *data, GLuint alignment = 4096);
+
+  /*!
+  ** \brief }bvoht@C.
+  **
+  **   t@CɃ}bv, 摜f[^͂ɃeNX`ɓ].
+  */
+  class GgBundle
+    : public Gg
+  {
+    // }bvt@C
+    GgMappedFile file;
+
+    // wb_
+    const GgBundleHeader *header;
+
+    // ڎ
+    const GgBundleEntry *entries;
+
+  public:
+
+    //! \brief fXgN^.
+    virtual ~GgBundle() {}
+
+    //! \brief RXgN^.
+    //!   \param name }bvoht@C.
+    GgBundle(const char *name);
+
+    //! \brief t@Cǂݍ߂ǂׂ.
+    //!   \return ǂݍ߂Ă true.
+    bool isValid() const
+    {
+      return header != nullptr;
+    }
+
+    //! \brief i[Ă摜̐𓾂.
+    //!   \return i[Ă摜̐.
+    GLuint count() const
+    {
+      return header ? header->count : 0;
+    }
+
+    //! \brief ڎ̍ڂ𓾂.
+    //!   \param i 摜̔ԍ.
+    //!   \return ڎ̍.
+    const GgBundleEntry &entry(GLuint i) const
+    {
+      return entries[i];
+    }
+
+    //! \brief 摜f[^𓾂.
+    //!   \param i 摜̔ԍ.
+    //!   \return }bvt@C̉摜f[^̐擪̃AhX.
+    const GLvoid *data(GLuint i) const
+    {
+      return file.data() + entries[i].offset;
+    }
+
+    //! \brief 摜 GL_TEXTURE_2D ̃eNX`ɓ].
+    //!   \param i 摜̔ԍ.
+    //!   \param tex ]̃eNX` (0 ȂV).
+    //!   \return eNX`.
+    GLuint loadTexture(GLuint i, GLuint tex = 0) const;
+
+    //! \brief A摜 GL_TEXTURE_2D_ARRAY ̃eNX`̊eCɓ].
+    //!   \brief EF̓CƂɐݒłȂ̂ōŏ̉摜̂̂g. 摜Ƃ̋EF entry() Ŏo.
+    //!   \param first ŏ̃Cɂ摜̔ԍ.
+    //!   \param layers C (0 Ȃ first ȍ~ׂ̂Ẳ摜).
+    //!   \param tex ]̃eNX` (0 ȂV).
+    //!   \return eNX` (摜̑傫⏑ĂȂ 0).
+    GLuint loadArray(GLuint first = 0, GLuint layers = 0, GLuint tex = 0) const;
+  };
+
   /*!
   ** \brief QƃJE^.
   **
@@ -4647,8 +5412,8 @@ namespace gg
       // QƂĂIuWFNgȂeNX`폜
       if (last())
       {
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glDeleteTextures(1, &texture);
+        ggBindTexture(GL_TEXTURE_2D, 0);
+        ggDeleteTextures(1, &texture);
       }
     }
 
@@ -4696,15 +5461,15 @@ namespace gg
     //!   \param unit gpeNX`jbgԍi0`j.
     void use(GLuint unit = 0) const
     {
-      glActiveTexture(GL_TEXTURE0 + unit);
-      glBindTexture(GL_TEXTURE_2D, texture);
+      ggActiveTexture(GL_TEXTURE0 + unit);
+      ggBindTexture(GL_TEXTURE_2D, texture);
     }
 
     //! \brief eNX`̎gpI (̃eNX`gpȂȂĂяo).
     void unuse() const
     {
-      glBindTexture(GL_TEXTURE_2D, 0);
-      glActiveTexture(GL_TEXTURE0);
+      ggBindTexture(GL_TEXTURE_2D, 0);
+      ggActiveTexture(GL_TEXTURE0);
     }
 
     //! \brief gpĂeNX`̃eNX`𓾂.
@@ -4884,7 +5649,7 @@ namespace gg
     //! \brief fXgN^.
     virtual ~GgShape()
     {
-      glBindVertexArray(0);
+      ggBindVertexArray(0);
       glDeleteVertexArrays(1, &vao);
     }
 
@@ -4894,14 +5659,14 @@ namespace gg
     {
       this->mode = mode;
       glGenVertexArrays(1, &vao);
-      glBindVertexArray(vao);
+      ggBindVertexArray(vao);
     }
 
     //! \brief Rs[RXgN^.
     GgShape(const GgShape &o)
       : vao(o.vao), mode(o.mode)
     {
-      glBindVertexArray(vao);
+      ggBindVertexArray(vao);
     }
 
     // Zq
@@ -4911,7 +5676,7 @@ namespace gg
       {
         vao = o.vao;
         mode = o.mode;
-        glBindVertexArray(vao);
+        ggBindVertexArray(vao);
       }
       return *this;
     }
@@ -4919,7 +5684,7 @@ namespace gg
     //! \brief ̐}`̒_zIuWFNgw肷.
     void use() const
     {
-      glBindVertexArray(vao);
+      ggBindVertexArray(vao);
     }
 
     //! \brief _zIuWFNgo.
@@ -5146,8 +5911,17 @@ namespace gg
   class GgElements
     : public GgTriangles
   {
-    // CfbNXi[钸_obt@IuWFNg
-    GgBuffer<GLuint[3]> index;
+    // CfbNXi[钸_obt@IuWFNg (16 rbg 32 rbg̃CfbNXŋp)
+    GgBuffer<GLubyte> index;
+
+    // CfbNX̃f[^^ (GL_UNSIGNED_SHORT  GL_UNSIGNED_INT)
+    GLenum type;
+
+    // Op`̃CfbNX̃oCg
+    GLuint stride() const
+    {
+      return type == GL_UNSIGNED_SHORT ? sizeof (GLushort[3]) : sizeof (GLuint[3]);
+    }
 
   public:
 
@@ -5157,7 +5931,7 @@ namespace gg
     //! \brief RXgN^.
     //!   \param mode `悷{}`̎.
     GgElements(GLenum mode = GL_TRIANGLES)
-      : GgTriangles(mode) {}
+      : GgTriangles(mode), type(GL_UNSIGNED_INT) {}
 
     //! \brief RXgN^.
     //!   \param nv _.
@@ -5169,14 +5943,29 @@ namespace gg
     //!   \param usage obt@IuWFNg̎g.
     GgElements(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
       GLuint nf, const GLuint (*face)[3], GLenum mode = GL_TRIANGLES, GLenum usage = GL_STATIC_DRAW)
-      : GgTriangles(nv, pos, norm, mode, usage)
+      : GgTriangles(nv, pos, norm, mode, usage), type(GL_UNSIGNED_INT)
     {
-      index.load(GL_ELEMENT_ARRAY_BUFFER, nf, face);
+      index.load(GL_ELEMENT_ARRAY_BUFFER, nf * stride(), reinterpret_cast<const GLubyte *>(face));
+    }
+
+    //! \brief RXgN^ (16 rbg̃CfbNX).
+    //!   \param nv _ (65536 ȉ).
+    //!   \param pos ̐}`̒_̈ʒũf[^̔z (NULL Ȃf[^]Ȃ).
+    //!   \param norm ̐}`̒_̖@̃f[^̔z (NULL Ȃf[^]Ȃ).
+    //!   \param nf Op`.
+    //!   \param face Op` 16 rbg̒_CfbNX.
+    //!   \param mode `悷{}`̎.
+    //!   \param usage obt@IuWFNg̎g.
+    GgElements(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
+      GLuint nf, const GLushort (*face)[3], GLenum mode = GL_TRIANGLES, GLenum usage = GL_STATIC_DRAW)
+      : GgTriangles(nv, pos, norm, mode, usage), type(GL_UNSIGNED_SHORT)
+    {
+      index.load(GL_ELEMENT_ARRAY_BUFFER, nf * stride(), reinterpret_cast<const GLubyte *>(face));
     }
 
     //! \brief Rs[RXgN^.
     GgElements(const GgElements &o)
-      : GgTriangles(o), index(o.index) {}
+      : GgTriangles(o), index(o.index), type(o.type) {}
 
     // 
     GgElements &operator=(const GgElements &o)
@@ -5185,6 +5974,7 @@ namespace gg
       {
         GgTriangles::operator=(o);
         index = o.index;
+        type = o.type;
       }
       return *this;
     }
@@ -5193,10 +5983,15 @@ namespace gg
     //!   \param nf Op`.
     //!   \param face Op`̒_CfbNXf[^.
     //!   \param offset ]̃obt@IuWFNg̐擪̗vfԍ.
-    void send(GLuint nf, const GLuint (*face)[3], GLuint offset = 0)
-    {
-      index.send(nf, face, offset);
-    }
+    //!   \note 16 rbg̃CfbNX̃obt@IuWFNgɂ 16 rbgɕϊē] (65535 𒴂CfbNXΓ]Ȃ).
+    void send(GLuint nf, const GLuint (*face)[3], GLuint offset = 0);
+
+    //! \brief ̃obt@IuWFNgɎOp` 16 rbg̒_CfbNXf[^].
+    //!   \param nf Op`.
+    //!   \param face Op` 16 rbg̒_CfbNXf[^.
+    //!   \param offset ]̃obt@IuWFNg̐擪̗vfԍ.
+    //!   \note 32 rbg̃CfbNX̃obt@IuWFNgɂ 32 rbgɕϊē].
+    void send(GLuint nf, const GLushort (*face)[3], GLuint offset = 0);
 
     //! \brief obt@IuWFNgmۂĒ_̈ʒuf[^Ɩ@f[^ƎOp`̒_CfbNXf[^i[.
     //!   \param nv _̃f[^̐ (_).
@@ -5209,7 +6004,23 @@ namespace gg
       GLuint nf, const GLuint (*face)[3], GLenum usage = GL_STATIC_DRAW)
     {
       GgTriangles::load(nv, pos, norm, usage);
-      index.load(GL_ELEMENT_ARRAY_BUFFER, nf, face);
+      type = GL_UNSIGNED_INT;
+      index.load(GL_ELEMENT_ARRAY_BUFFER, nf * stride(), reinterpret_cast<const GLubyte *>(face), usage);
+    }
+
+    //! \brief obt@IuWFNgmۂĒ_̈ʒuf[^Ɩ@f[^ƎOp` 16 rbg̒_CfbNXf[^i[.
+    //!   \param nv _̃f[^̐ (_, 65536 ȉ).
+    //!   \param pos _̈ʒuf[^i[ĂĂ̈̐擪̃|C^.
+    //!   \param norm _̖@f[^i[ĂĂ̈̐擪̃|C^.
+    //!   \param nf Op`.
+    //!   \param face Op` 16 rbg̒_CfbNXf[^.
+    //!   \param usage obt@IuWFNg̎g.
+    void load(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
+      GLuint nf, const GLushort (*face)[3], GLenum usage = GL_STATIC_DRAW)
+    {
+      GgTriangles::load(nv, pos, norm, usage);
+      type = GL_UNSIGNED_SHORT;
+      index.load(GL_ELEMENT_ARRAY_BUFFER, nf * stride(), reinterpret_cast<const GLubyte *>(face), usage);
     }
 
     //! \brief Op`̒_CfbNXf[^i[_obt@IuWFNgo.
@@ -5222,6 +6033,132 @@ namespace gg
     //! \brief f[^̐o.
     //!   \return ̐}`̎Op`.
     GLuint fnum() const
+    {
+      return index.num() / stride();
+    }
+
+    //! \brief CfbNX̃f[^^o.
+    //!   \return GL_UNSIGNED_SHORT  GL_UNSIGNED_INT.
+    GLenum ftype() const
+    {
+      return type;
+    }
+
+    //! \brief Op``悷葱.
+    virtual void draw(GLint first = 0, GLsizei count = 0) const;
+  };
+
+  /*!
+  ** \brief ʎq_f[^ŕ\Op`̌`f[^.
+  **
+  **   ggQuantizeVertices() ŗʎqʒuƖ@̒_obt@IuWFNgɋl,
+  **   ʒu index == 0, ʑ̎ʑ@ index == 1  in ϐ͂.
+  **   Op`̒_CfbNX^ Elements `ŕ`悷.
+  **   Œ@\̒_zɂ͎gȂ̂, ggQuantizedDecoder gݍ񂾃VF[_ŕ`
+  **   (Tv main.cpp ͂̃NXgȂ).
+  */
+  class GgQuantizedTriangles
+    : public GgShape
+  {
+    // ʎq_f[^i[钸_obt@IuWFNg
+    GgBuffer<GLubyte> vertex;
+
+    // CfbNXi[钸_obt@IuWFNg
+    GgBuffer<GLuint[3]> index;
+
+    // @̐̃f[^^
+    GLenum type;
+
+    // ʒu̕Ɏg AABB ̑傫ƍŏl
+    GLfloat scale[3], offset[3];
+
+  public:
+
+    //! \brief fXgN^.
+    virtual ~GgQuantizedTriangles() {}
+
+    //! \brief RXgN^.
+    //!   \param nv _.
+    //!   \param pos ̐}`̒_̈ʒũf[^̔z.
+    //!   \param norm ̐}`̒_̖@̃f[^̔z.
+    //!   \param nf Op` (0 Ȃ Arrays `).
+    //!   \param face Op`̒_CfbNX (nullptr Ȃ Arrays `).
+    //!   \param type @̐̃f[^^ (GL_SHORT  GL_BYTE).
+    //!   \param mode `悷{}`̎.
+    //!   \param usage obt@IuWFNg̎g.
+    GgQuantizedTriangles(GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3],
+      GLuint nf = 0, const GLuint (*face)[3] = nullptr, GLenum type = GL_SHORT,
+      GLenum mode = GL_TRIANGLES, GLenum usage = GL_STATIC_DRAW);
+
+    //! \brief Rs[RXgN^.
+    GgQuantizedTriangles(const GgQuantizedTriangles &o)
+      : GgShape(o), vertex(o.vertex), index(o.index), type(o.type)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = o.scale[i];
+        offset[i] = o.offset[i];
+      }
+    }
+
+    // 
+    GgQuantizedTriangles &operator=(const GgQuantizedTriangles &o)
+    {
+      if (&o != this)
+      {
+        GgShape::operator=(o);
+        vertex = o.vertex;
+        index = o.index;
+        type = o.type;
+        for (int i = 0; i < 3; ++i)
+        {
+          scale[i] = o.scale[i];
+          offset[i] = o.offset[i];
+        }
+      }
+      return *this;
+    }
+
+    //! \brief ʒu̕Ɏg AABB ̑傫o.
+    //!   \return AABB ̑傫i[ 3 vf̔z.
+    const GLfloat *getScale() const
+    {
+      return scale;
+    }
+
+    //! \brief ʒu̕Ɏg AABB ̍ŏlo.
+    //!   \return AABB ̍ŏli[ 3 vf̔z.
+    const GLfloat *getOffset() const
+    {
+      return offset;
+    }
+
+    //! \brief ggQuantizedDecoder  uniform ϐݒ肷.
+    //!   \param program ggQuantizedDecoder gݍ񂾎gp̃vOIuWFNg.
+    void setDecoder(GLuint program) const
+    {
+      glUniform3fv(glGetUniformLocation(program, "qscale"), 1, scale);
+      glUniform3fv(glGetUniformLocation(program, "qoffset"), 1, offset);
+      glUniform1f(glGetUniformLocation(program, "qrange"), type == GL_BYTE ? 127.0f : 32767.0f);
+    }
+
+    //! \brief _f[^i[_obt@IuWFNgo.
+    //!   \return ̐}`̗ʎq_f[^i[_obt@IuWFNg.
+    GLuint vbuf() const
+    {
+      return vertex.buf();
+    }
+
+    //! \brief _o.
+    //!   \return ̐}`̒_.
+    GLuint vnum() const
+    {
+      return vertex.num() / (type == GL_BYTE ? 8 : 12);
+    }
+
+    //! \brief Op`o.
+    //!   \return ̐}`̎Op` (Arrays `Ȃ 0).
+    GLuint fnum() const
     {
       return index.num();
     }
@@ -5337,7 +6274,7 @@ namespace gg
       // QƂĂIuWFNgȂVF[_폜
       if (program != 0 && last())
       {
-        glUseProgram(0);
+        ggUseProgram(0);
         glDeleteProgram(program);
       }
     }
@@ -5377,7 +6314,7 @@ namespace gg
     {
       if (program != 0 && newCounter())
       {
-        glUseProgram(0);
+        ggUseProgram(0);
         glDeleteProgram(program);
       }
       program = newProgram;
@@ -5398,13 +6335,13 @@ namespace gg
     //! \brief VF[_vO̎gpJn.
     void use() const
     {
-      glUseProgram(program);
+      ggUseProgram(program);
     }
 
     //! \brief VF[_vO̎gpI.
     void unuse() const
     {
-      glUseProgram(0);
+      ggUseProgram(0);
     }
 
     //! \brief VF[_̃vO𓾂.
@@ -5782,7 +6719,7 @@ namespace gg
     GLfloat (*diff)[4];                     // |SO[vƂ̊gUˌW
     GLfloat (*spec)[4];                     // |SO[vƂ̋ʔˌW
     GLfloat *shi;                           // |SO[vƂ̋PW
-    GgTriangles *data;                      // ̐}`̌`f[^
+    GgTriangles *data;                      // ̐}`̌`f[^ (CfbNXgƂ GgElements)
     GgSimpleShader *shader;                 // VF[_
 
   public:
@@ -5791,7 +6728,10 @@ namespace gg
     virtual ~GgObj();
 
     //! \brief RXgN^.
-    GgObj(const char *name, bool normalize = false);
+    //!   \param name ǂݍ Wavefront OBJ t@C.
+    //!   \param normalize true Ȃǂݍ񂾃f[^̑傫𐳋K.
+    //!   \param indexed true Ȃd̂Ȃ_ƃCfbNXg GgElements `ɂ.
+    GgObj(const char *name, bool normalize = false, bool indexed = false);
 
     //! \brief `f[^̎o.
     //!   \return GgTriangles ^̌`f[^̃|C^.
@@ -0,0 +1,37 @@
+#version 120
+//
+// 放射照度マッピング (インスタンシング)
+//
+
+// 変換行列
+uniform mat4 mw;                                    // 視点座標系への変換行列
+uniform mat4 mc;                                    // クリッピング座標系への変換行列
+uniform mat4 mg;                                    // 法線ベクトルの変換行列
+
+// 材質のパレット (main.cpp の instanceDiffuse / instanceSpecular)
+uniform vec4 pdiff[8];                              // 拡散反射係数
+uniform vec4 pspec[8];                              // 鏡面反射係数
+
+// インスタンスごとの属性 (頂点属性の除数を 1 にしてインスタンスごとに一つ進める)
+attribute mat4 mi;                                  // モデル変換行列 (回転と一様な拡大縮小と平行移動)
+attribute float material;                           // 材質の番号
+
+// ラスタライザに送る頂点属性
+varying vec3 n;                                     // 視点座標系の法線ベクトル
+varying vec3 v;                                     // 視点から頂点に向かうベクトル
+
+void main(void)
+{
+  // 頂点位置と法線ベクトルは固定機能の頂点配列から取り出してインスタンスの位置に置く
+  vec4 q = mi * gl_Vertex;
+  vec4 p = mw * q;
+  v = p.xyz / p.w;
+  n = (mg * (mi * vec4(gl_Normal, 0.0))).xyz;
+
+  // 拡散反射係数と鏡面反射係数は材質の番号でパレットから選ぶ
+  int m = int(material);
+  gl_FrontColor = pdiff[m];
+  gl_FrontSecondaryColor = pspec[m];
+
+  gl_Position = mc * q;
+}
@@ -0,0 +1,47 @@
+#version 120
+#extension GL_EXT_texture_array : require
+//
+// 放射照度マッピング
+//
+
+// テクスチャ (すべてのマップをレイヤに並べたテクスチャ配列)
+uniform sampler2DArray imap;                        // 放射照度マップ
+uniform sampler2DArray emap;                        // 環境マップ
+uniform float layer;                                // 使うマップのレイヤ
+uniform vec3 iborder;                               // 使う放射照度マップの境界色
+uniform vec3 eborder;                               // 使う環境マップの境界色
+
+// 明るさ
+uniform vec4 lamb;                                  // 放射照度マップのかさ上げ (HDR では露出)
+uniform float exposure;                             // 0 なら lamb を加算, 正なら lamb とこの値を乗算
+
+// ラスタライザから受け取る頂点属性の補間値
+varying vec3 n;                                     // 視点座標系の法線ベクトル
+varying vec3 v;                                     // 視点から頂点に向かうベクトル
+
+// 方向ベクトルを放物面マップのテクスチャ座標に変換する (main.cpp の paraboloid と同じ)
+vec2 paraboloid(const in vec3 d)
+{
+  return 0.5 - d.xz / max(2.0 + 2.0 * d.y, 1.0e-6);
+}
+
+// 選んだレイヤのマップを参照する (テクスチャ配列の境界色はレイヤごとに変えられないので範囲外は境界色にする)
+vec3 lookup(in sampler2DArray map, const in vec2 t, const in vec3 border)
+{
+  return any(notEqual(clamp(t, 0.0, 1.0), t)) ? border : texture2DArray(map, vec3(t, layer)).rgb;
+}
+
+void main(void)
+{
+  vec3 nn = normalize(n);
+  vec3 r = reflect(normalize(v), nn);
+
+  // 放射照度マップを一度だけ参照してかさ上げする Ce ← Cb + Ct または Cb * Ct * exposure
+  vec3 irr = lookup(imap, paraboloid(nn), iborder);
+  vec3 e = clamp(exposure > 0.0 ? lamb.rgb * irr * exposure : lamb.rgb + irr, 0.0, 1.0);
+
+  // 物体の色 (gl_Color) に入射光強度をかけ, 環境マップの値と鏡面反射係数 (gl_SecondaryColor) で比例配分する C ← Ct * Cs + Cd * (1 - Cs)
+  vec3 cd = gl_Color.rgb * e;
+  vec3 ct = lookup(emap, paraboloid(r), eborder);
+  gl_FragColor = vec4(mix(cd, ct, gl_SecondaryColor.rgb), gl_Color.a);
+}
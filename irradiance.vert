@@ -0,0 +1,30 @@
+#version 120
+//
+// 放射照度マッピング
+//
+
+// 変換行列
+uniform mat4 mw;                                    // 視点座標系への変換行列
+uniform mat4 mc;                                    // クリッピング座標系への変換行列
+uniform mat4 mg;                                    // 法線ベクトルの変換行列
+
+// 材質
+uniform vec4 kspec;                                 // 鏡面反射係数
+
+// ラスタライザに送る頂点属性
+varying vec3 n;                                     // 視点座標系の法線ベクトル
+varying vec3 v;                                     // 視点から頂点に向かうベクトル
+
+void main(void)
+{
+  // 頂点位置と法線ベクトルは固定機能の頂点配列から取り出す
+  vec4 p = mw * gl_Vertex;
+  v = p.xyz / p.w;
+  n = (mg * vec4(gl_Normal, 0.0)).xyz;
+
+  // 拡散反射係数は primary color (頂点色) をそのまま使い, 鏡面反射係数は secondary color で送る
+  gl_FrontColor = gl_Color;
+  gl_FrontSecondaryColor = kspec;
+
+  gl_Position = mc * gl_Vertex;
+}
@@ -1,16 +1,31 @@
 #define _USE_MATH_DEFINES
 #define NOMINMAX
 #include <cmath>
+#include <cfloat>
 #include <cstdlib>
+#include <cstring>
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
 
 // OvZ}bvgpȂ 1
 #define USEMAP 1
 
+// }bv쐬Ƃx_ (RGB16F) ŕۑȂ 1
+#define HDRMAP 0
+
+// ʏ̑傫ɍ킹Č`̏ڍדx (LOD) ؂ւȂ 1
+#define USELOD 1
+
+// ˏƓx}bsOeNX`ł͂ȂVF[_ōsȂ 1
+#define USESHADER 1
+
+// CX^VOŕ`Ƃ BVH ɂ鎋JOsȂ 1
+#define USECULLING 1
+
 // EBhE֘Ȁ
 #include "Window.h"
 
@@ -21,6 +36,13 @@ namespace
   //
   const char filename[] = "bunny.obj";
 
+#if USELOD
+  //
+  // ڍדxIԂƂɋʏ̌덷 (f)
+  //
+  const GLfloat lodTolerance(1.0f);
+#endif
+
 #if USEMAP
   //
   // ˏƓx}bv
@@ -76,6 +98,16 @@ namespace
   // ˏƓx}bv̐
   //
   const size_t mapcount(sizeof irrmaps / sizeof irrmaps[0]);
+
+  //
+  // ˏƓx}bvƊ}bv܂Ƃ߂}bvoht@C (tools/ggpack ō쐬)
+  //
+  const char bundlename[] = "maps.ggb";
+
+  //
+  // x_̕ˏƓx}bvƊ}bv܂Ƃ߂}bvoht@C (HDRMAP  1 ɂč쐬)
+  //
+  const char hdrbundlename[] = "hdrmaps.ggb";
 #else
   //
   // ˉe̋჌YŎBeV摜
@@ -116,6 +148,11 @@ namespace
   //
   const GLsizei skysize(1024);
 
+  //
+  // V̈ǂݍނƂɏk傫 (0 ȂkȂ)
+  //
+  const GLsizei skyresolution(0);
+
   //
   // 쐬eNX`̃TCY
   //
@@ -127,7 +164,51 @@ namespace
   //
   const unsigned int isamples(256);
   const unsigned int esamples(256);
+
+#if HDRMAP
+  //
+  // 쐬}bv𔼐x_ł܂Ƃ߂}bvoht@C
+  //
+  const char bundlename[] = "hdrmaps.ggb";
+#else
+  //
+  // 쐬}bv BC1 `ɈkĂ܂Ƃ߂}bvoht@C
+  //
+  const char bundlename[] = "genmaps.ggb";
 #endif
+#endif
+
+  //
+  // CX^VOŕ``̐̏
+  //
+  const GLsizei maxInstances(100000);
+
+  //
+  // CX^X̍ގ̃pbg (instanced.vert  pdiff / pspec ̗vfƍ킹)
+  //
+  const int instanceMaterials(8);
+  const GLfloat instanceDiffuse[instanceMaterials][4] =
+  {
+    { 0.8f, 0.8f, 0.8f, 1.0f },
+    { 0.8f, 0.2f, 0.2f, 1.0f },
+    { 0.2f, 0.7f, 0.2f, 1.0f },
+    { 0.2f, 0.3f, 0.8f, 1.0f },
+    { 0.8f, 0.7f, 0.2f, 1.0f },
+    { 0.6f, 0.2f, 0.7f, 1.0f },
+    { 0.2f, 0.7f, 0.7f, 1.0f },
+    { 0.1f, 0.1f, 0.1f, 1.0f }
+  };
+  const GLfloat instanceSpecular[instanceMaterials][4] =
+  {
+    { 0.1f, 0.1f, 0.1f, 1.0f },
+    { 0.2f, 0.2f, 0.2f, 1.0f },
+    { 0.1f, 0.1f, 0.1f, 1.0f },
+    { 0.3f, 0.3f, 0.3f, 1.0f },
+    { 0.5f, 0.5f, 0.5f, 1.0f },
+    { 0.2f, 0.2f, 0.2f, 1.0f },
+    { 0.1f, 0.1f, 0.1f, 1.0f },
+    { 0.8f, 0.8f, 0.8f, 1.0f }
+  };
 
   //
   // ʃ}bsOp̃eNX`ϊs
@@ -141,88 +222,488 @@ namespace
   };
 
   //
-  // ̕`
+  // ˏƓx}bsÕVF[_
+  //
+  //   Œ@\ł͎O̃eNX`jbgōsĂˏƓx}bv̂グ, gUˌx̎Zo,
+  //   }bvƂ̔z̃tOgVF[_̏ōs. ˏƓx}bv͈xQƂȂ.
+  //   邳͌x̊ (lamb), ʔˌW͍ގ̋ʔˌW (kspec)  uniform ϐŗ^,
+  //   gUˌWƒ_ʒu, @xNg͌Œ@\Ɠ_z primary color o.
+  //   }bvׂ͂Ẵ}bvCɕׂeNX`z񂩂QƂ, g}bv̓C̔ԍ (layer) őI.
   //
-  void floor(int size, GLfloat height)
+  class IrradianceShader
+    : public GgSimpleShader
   {
-    // ^CP̒_f[^
-    static const GLfloat floorvert[] =
+    // g}bṽCƂ̋EF uniform ϐ̏ꏊ
+    GLint layerLoc, iborderLoc, eborderLoc;
+
+  public:
+
+    // RXgN^
+    //   hdr: x_̃}bvȂ true
+    IrradianceShader(const char *vert, const char *frag, bool hdr)
+      : GgSimpleShader(vert, frag), layerLoc(-1), iborderLoc(-1), eborderLoc(-1)
     {
-      0.0f, 0.0f, 0.0f,
-      0.0f, 0.0f, 1.0f,
-      1.0f, 0.0f, 1.0f,
-      1.0f, 0.0f, 0.0f
-    };
+      // vO
+      const GLuint program(get());
+      if (program == 0) return;
+
+      // g}bṽCƂ̋EF uniform ϐ̏ꏊ
+      layerLoc = glGetUniformLocation(program, "layer");
+      iborderLoc = glGetUniformLocation(program, "iborder");
+      eborderLoc = glGetUniformLocation(program, "eborder");
+
+      // ˏƓx}bv̓eNX`jbg 0, }bv̓eNX`jbg 1 ̃eNX`z񂩂QƂ
+      ggUseProgram(program);
+      glUniform1i(glGetUniformLocation(program, "imap"), 0);
+      glUniform1i(glGetUniformLocation(program, "emap"), 1);
+
+      // x_̃}bvł͖邳IoƂ 4 {Ă
+      glUniform1f(glGetUniformLocation(program, "exposure"), hdr ? 4.0f : 0.0f);
+      ggUseProgram(0);
+    }
+
+    // g}bṽCƂ̋EFݒ肷 (̃VF[_gpɌĂ)
+    //   eNX`z̋EF̓CƂɕςȂ̂, I񂾃}bv̋EFVF[_Ŏg
+    void setLayer(GLint layer, const GLfloat *iborder, const GLfloat *eborder) const
+    {
+      glUniform1f(layerLoc, GLfloat(layer));
+      glUniform3fv(iborderLoc, 1, iborder);
+      glUniform3fv(eborderLoc, 1, eborder);
+    }
+  };
+
+  //
+  // CX^VOŕˏƓx}bsOsVF[_
+  //
+  //   CX^XƂ̃fϊs (mi) ƍގ̔ԍ (material) 𒸓_̏ 1 ɂ
+  //   attribute ϐŎ󂯎, ގ̔ԍ uniform ϐ̃pbggUˌWƋʔˌWI.
+  //
+  class InstancedShader
+    : public IrradianceShader
+  {
+    // CX^XƂ attribute ϐ̏ꏊ
+    GLint matrixLoc, materialLoc;
+
+  public:
+
+    // RXgN^
+    //   hdr: x_̃}bvȂ true
+    InstancedShader(const char *vert, const char *frag, bool hdr)
+      : IrradianceShader(vert, frag, hdr), matrixLoc(-1), materialLoc(-1)
+    {
+      // vO
+      const GLuint program(get());
+      if (program == 0) return;
+
+      // CX^XƂ attribute ϐ̏ꏊ
+      matrixLoc = glGetAttribLocation(program, "mi");
+      materialLoc = glGetAttribLocation(program, "material");
+
+      // ގ̃pbgݒ肷
+      ggUseProgram(program);
+      glUniform4fv(glGetUniformLocation(program, "pdiff"), instanceMaterials, instanceDiffuse[0]);
+      glUniform4fv(glGetUniformLocation(program, "pspec"), instanceMaterials, instanceSpecular[0]);
+      ggUseProgram(0);
+    }
+
+    // fϊs attribute ϐ̏ꏊ (4 ̗񂪑ꏊg)
+    GLint getMatrixLocation() const
+    {
+      return matrixLoc;
+    }
+
+    // ގ̔ԍ attribute ϐ̏ꏊ
+    GLint getMaterialLocation() const
+    {
+      return materialLoc;
+    }
+  };
 
+  //
+  // ̒_
+  //
+  struct FloorVertex
+  {
+    GLfloat position[3];  // ʒu
+    GLfloat color[3];     // ^C̊gUˌW
+  };
+
+  //
+  // ̍쐬
+  //
+  //   size: ̒S[܂ł̃^C̐
+  //   height: ̍
+  //   vao: ̒_zIuWFNg
+  //   buffer: ̒_ƃCfbNXi[ 2 ̒_obt@IuWFNg
+  //   ߂l: `Ƃ̃CfbNX̐
+  //
+  //   Ŝiq̒_ƎOp`̃CfbNXɂĈx]Ă, ̕`ŕ`.
+  //   ׂ荇^C͒_L̂, ^C̐F̓tbgVF[fBO
+  //   Op`̍Ō̒_ (provoking vertex) ̐Fg. ^C (i, j) ̓̎Op`
+  //   Ō̒_iq_ (i + 1, j + 1)  (i, j) ɂ, ̐F̓^C̎s͗l̐Fƈv.
+  //
+  GLsizei createFloor(int size, GLfloat height, GLuint vao, const GLuint *buffer)
+  {
     // ^C̊gUˌW
-    static const GLfloat floordiff[][4] =
+    static const GLfloat floordiff[][3] =
     {
-      { 0.6f, 0.6f, 0.6f, 1.0f },
-      { 0.3f, 0.3f, 0.3f, 1.0f }
+      { 0.6f, 0.6f, 0.6f },
+      { 0.3f, 0.3f, 0.3f }
     };
 
+    // iq̈ӂ̒_
+    const int n(size * 2 + 1);
+
+    // iq_̒_
+    std::vector<FloorVertex> vert(n * n);
+    for (int j = -size; j <= size; ++j)
+    {
+      for (int i = -size; i <= size; ++i)
+      {
+        FloorVertex &v(vert[(j + size) * n + i + size]);
+        v.position[0] = GLfloat(i);
+        v.position[1] = height;
+        v.position[2] = GLfloat(j);
+        std::copy(floordiff[(i + j) & 1], floordiff[(i + j) & 1] + 3, v.color);
+      }
+    }
+
+    // ^CƂ̓̎Op`̒_CfbNX
+    std::vector<GLuint> index;
+    index.reserve((n - 1) * (n - 1) * 6);
+    for (int j = 0; j < n - 1; ++j)
+    {
+      for (int i = 0; i < n - 1; ++i)
+      {
+        // ^C̎l̊iq_
+        const GLuint v0(j * n + i), v1(v0 + n), v2(v1 + 1), v3(v0 + 1);
+
+        // ڂ̎Op`̍Ō̒_ (i + 1, j + 1)
+        index.push_back(v0);
+        index.push_back(v1);
+        index.push_back(v2);
+
+        // ڂ̎Op`̍Ō̒_ (i, j)
+        index.push_back(v2);
+        index.push_back(v3);
+        index.push_back(v0);
+      }
+    }
+
+    // ̒_zIuWFNg
+    ggBindVertexArray(vao);
+
+    // ̒_ʒuƐF (FloorVertex ̈ʒu 3 vf̌) 𒸓_obt@IuWFNg擾
+    glBindBuffer(GL_ARRAY_BUFFER, buffer[0]);
+    glBufferData(GL_ARRAY_BUFFER, vert.size() * sizeof (FloorVertex), &vert[0], GL_STATIC_DRAW);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof (FloorVertex), static_cast<const GLfloat *>(0));
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer(3, GL_FLOAT, sizeof (FloorVertex), static_cast<const GLfloat *>(0) + 3);
+
+    // ̃|S̖@xNg glNormal3f() Őݒ肷
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    // ̎Op`̒_CfbNX
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, index.size() * sizeof (GLuint), &index[0], GL_STATIC_DRAW);
+
+    // _zIuWFNǧ
+    ggBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return static_cast<GLsizei>(index.size());
+  }
+
+  //
+  // ̕`
+  //
+  //   vao: createFloor() ō쐬̒_zIuWFNg
+  //   count: createFloor() ̖߂l
+  //   shader: gp̃VF[_ (nullptr ȂeNX`ŕ`)
+  //
+  void floor(GLuint vao, GLsizei count, IrradianceShader *shader)
+  {
     // ^C̋ʔˌW
     static const GLfloat floorspec[] =
     {
       0.1f, 0.1f, 0.1f, 1.0f
     };
 
-    // ̃|S̒_ʒu𒸓_z񂩂擾
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(3, GL_FLOAT, 0, floorvert);
-
     // ̃|S̖@xNg glNormal3f() Őݒ肷
-    glDisableClientState(GL_NORMAL_ARRAY);
     glNormal3f(0.0f, 1.0f, 0.0f);
 
     // ̃|S̊gUˌƋʔˌʔˌWŔz
-    glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, floorspec);
+    if (shader)
+    {
+      // CX^VOŕʂ̃VF[_gĂ邱Ƃ̂őIђ
+      shader->use();
+      shader->setMaterialSpecular(floorspec);
+    }
+    else
+      ggTexEnvfv(GL_TEXTURE_ENV_COLOR, floorspec);
 
-    // ̕`
-    for (int j = -size; j < size; ++j)
+    // Ŝxɕ`悷 (^C̊gUˌW primary color (_F) ɂȂ)
+    ggBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, 0);
+
+    // _z̐FĝŌ݂̐F͕sɂȂ
+    ggColor4fv(nullptr);
+  }
+
+  //
+  // `̒_zIuWFNgɌŒ@\̒_zo^
+  //
+  //   GgTriangles ͒_ʒuƖ@ index == 0, 1  in ϐɊ蓖Ă̂,
+  //   _obt@IuWFNg glVertexPointer() / glNormalPointer() ɂ蓖Ă,
+  //   eNX`ɂŒ@\̕`łVF[_ɂ`ł_zIuWFNgg.
+  //
+  void attachArrays(const GgTriangles &shape)
+  {
+    // `̒_zIuWFNg
+    shape.use();
+
+    // IuWFNg̒_ʒu𒸓_obt@IuWFNg擾
+    glBindBuffer(GL_ARRAY_BUFFER, shape.pbuf());
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, 0);
+
+    // IuWFNg̖@xNg𒸓_obt@IuWFNg擾
+    glBindBuffer(GL_ARRAY_BUFFER, shape.nbuf());
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, 0, 0);
+
+    // _zIuWFNǧ
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ggBindVertexArray(0);
+  }
+
+  //
+  // CX^XƂ̃f[^
+  //
+  struct Instance
+  {
+    GLfloat matrix[16];   // fϊs
+    GLfloat material;     // ގ̔ԍ
+  };
+
+  //
+  // CX^X̍쐬
+  //
+  //   count: CX^X̐
+  //   radius: `̒Sł_܂ł̋
+  //   height: ̍
+  //   shape: CX^XƂĕ``
+  //   shader: CX^VÕVF[_
+  //   vao: CX^VOɎg_zIuWFNg
+  //   buffer: CX^XƂ̃f[^i[钸_obt@IuWFNg
+  //   instance: 쐬CX^XƂ̃f[^̊i[
+  //
+  //   CX^X͏̏̈ 4 ̐`͈̔͂Ɋiqɕ, c܂ɂ΂΂ɉ].
+  //   `̒_zIuWFNgƂ͕ʂ̒_zIuWFNgɌ`̒_obt@IuWFNg
+  //   CX^XƂ̃f[^蓖Ă̂, Œ@\̕`ɂ͉eȂ.
+  //   JOsƂ, t[̃CX^X̃f[^ buffer ɓ].
+  //
+  void createInstances(GLsizei count, GLfloat radius, GLfloat height,
+#if USELOD
+    const GgElements &shape,
+#else
+    const GgTriangles &shape,
+#endif
+    const InstancedShader &shader, GLuint vao, GLuint buffer, std::vector<Instance> &instance)
+  {
+    // iq̈ӂ̃CX^X̐
+    GLsizei side(1);
+    while (side * side < count) ++side;
+
+    // iq̊Ԋuƌ`̊g嗦
+    const GLfloat spacing(4.0f / GLfloat(side));
+    const GLfloat scale(radius > 0.0f ? 0.4f * spacing / radius : 1.0f);
+
+    // CX^XƂ̃f[^
+    instance.resize(count);
+    for (GLsizei i = 0; i < count; ++i)
+    {
+      // iq_̈ʒu
+      const GLfloat x(spacing * (GLfloat(i % side) - 0.5f * GLfloat(side - 1)));
+      const GLfloat z(spacing * (GLfloat(i / side) - 0.5f * GLfloat(side - 1)));
+
+      // c܂̉]p (p炷)
+      const GLfloat angle(2.39996323f * GLfloat(i));
+
+      // ɍڂĉ]
+      const GgMatrix m(ggTranslate(x, height + scale * radius, z) * ggRotateY(angle) * ggScale(scale, scale, scale));
+      std::copy(m.get(), m.get() + 16, instance[i].matrix);
+      instance[i].material = GLfloat((i * 5 + i / side) % instanceMaterials);
+    }
+
+    // _zIuWFNg
+    ggBindVertexArray(vao);
+
+    // `̒_ʒuƖ@xNg͌Œ@\̒_zŎo
+    glBindBuffer(GL_ARRAY_BUFFER, shape.pbuf());
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, shape.nbuf());
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, 0, 0);
+#if USELOD
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape.fbuf());
+#endif
+
+    // CX^XƂ̃f[^]
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+#if USECULLING
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof (Instance), &instance[0], GL_STREAM_DRAW);
+#else
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof (Instance), &instance[0], GL_STATIC_DRAW);
+#endif
+
+    // fϊs 4 ̗𑱂 4  attribute Ɋ蓖, CX^XƂɈi߂
+    const GLint mi(shader.getMatrixLocation());
+    if (mi >= 0)
     {
-      for (int i = -size; i < size; ++i)
+      for (GLint c = 0; c < 4; ++c)
       {
-        // ̃|S̊gUˌW primary color (_F) ɐݒ肷
-        glColor3fv(floordiff[(i + j) & 1]);
-
-        // ̃|S`悷
-        glPushMatrix();
-        glTranslatef(GLfloat(i), height, GLfloat(j));
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-        glPopMatrix();
+        glEnableVertexAttribArray(mi + c);
+        glVertexAttribPointer(mi + c, 4, GL_FLOAT, GL_FALSE, sizeof (Instance),
+          static_cast<const GLfloat *>(0) + c * 4);
+        glVertexAttribDivisor(mi + c, 1);
       }
     }
+
+    // ގ̔ԍCX^XƂɈi߂
+    const GLint material(shader.getMaterialLocation());
+    if (material >= 0)
+    {
+      glEnableVertexAttribArray(material);
+      glVertexAttribPointer(material, 1, GL_FLOAT, GL_FALSE, sizeof (Instance),
+        static_cast<const GLfloat *>(0) + 16);
+      glVertexAttribDivisor(material, 1);
+    }
+
+    // _zIuWFNǧ
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    ggBindVertexArray(0);
   }
 
   //
   // V[̕`
   //
+  //   ` GPU ̒_obt@IuWFNgɒû`̂,
+  //   t[Ƃɒ_f[^]Ȃ.
+  //   shader: gp̃VF[_ (nullptr ȂeNX`ŕ`)
+  //
+#if USELOD
+  void scene(GLuint ng, const GLuint (*group)[2], const GLfloat (*diff)[4], const GLfloat (*spec)[4],
+    const GgElements &shape, IrradianceShader *shader)
+#else
   void scene(GLuint ng, const GLuint (*group)[2], const GLfloat (*diff)[4], const GLfloat (*spec)[4],
-    GLuint nv, const GLfloat (*pos)[3], const GLfloat (*norm)[3])
+    const GgTriangles &shape, IrradianceShader *shader)
+#endif
   {
-    // IuWFNg̒_ʒu𒸓_z񂩂擾
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(3, GL_FLOAT, 0, pos);
-
-    // IuWFNg̖@xNg𒸓_z񂩂擾
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glNormalPointer(GL_FLOAT, 0, norm);
+    // _ʒuƖ@xNg (ƎOp`̒_CfbNX) 𒸓_zIuWFNg擾
+    shape.use();
 
     // IuWFNg̕`
     for (unsigned int g = 0; g < ng; ++g)
     {
       // gUˌƋʔˌʔˌWŔz
-      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, spec[g]);
+      if (shader)
+        shader->setMaterialSpecular(spec[g]);
+      else
+        ggTexEnvfv(GL_TEXTURE_ENV_COLOR, spec[g]);
 
       // gUˌW primary color (_F) ɐݒ肷
-      glColor4fv(diff[g]);
+      ggColor4fv(diff[g]);
 
       // IuWFNg`悷
+#if USELOD
+      glDrawElements(GL_TRIANGLES, group[g][1], GL_UNSIGNED_INT, static_cast<const GLuint *>(0) + group[g][0]);
+#else
       glDrawArrays(GL_TRIANGLES, group[g][0], group[g][1]);
+#endif
+    }
+  }
+
+#if USECULLING
+  //
+  // CX^X AABB
+  //
+  //   instance: CX^X̃f[^
+  //   lower, upper: ` AABB ̍ŏlƍől
+  //   bmin, bmax: CX^X AABB ̍ŏlƍől̊i[
+  //
+  //   ` AABB ̒Sfϊsŕϊ, eӂ̔̒ɍs̗vf̐Βlđ̂
+  //   CX^X AABB ̊eӂ̔̒ɂ.
+  //
+  void instanceBounds(const Instance &instance, const GLfloat *lower, const GLfloat *upper,
+    GLfloat *bmin, GLfloat *bmax)
+  {
+    const GLfloat *const m(instance.matrix);
+    for (int i = 0; i < 3; ++i)
+    {
+      GLfloat center(m[12 + i]), extent(0.0f);
+      for (int j = 0; j < 3; ++j)
+      {
+        center += m[j * 4 + i] * (lower[j] + upper[j]) * 0.5f;
+        extent += fabs(m[j * 4 + i]) * (upper[j] - lower[j]) * 0.5f;
+      }
+      bmin[i] = center - extent;
+      bmax[i] = center + extent;
+    }
+  }
+#endif
+
+  //
+  // CX^VOɂV[̕`
+  //
+  //   count: CX^X̐
+  //   vao: createInstances() ō쐬_zIuWFNg
+  //   shader: CX^VÕVF[_
+  //   ގ̓CX^XƂɃpbgIԂ̂, ʃO[vƂɑSCX^Xxɕ`.
+  //
+  void instancedScene(GLuint ng, const GLuint (*group)[2], GLsizei count, GLuint vao, const InstancedShader &shader)
+  {
+    shader.use();
+    ggBindVertexArray(vao);
+
+    for (unsigned int g = 0; g < ng; ++g)
+    {
+#if USELOD
+      glDrawElementsInstanced(GL_TRIANGLES, group[g][1], GL_UNSIGNED_INT,
+        static_cast<const GLuint *>(0) + group[g][0], count);
+#else
+      glDrawArraysInstanced(GL_TRIANGLES, group[g][0], group[g][1], count);
+#endif
     }
   }
 
+#if USELOD
+  //
+  // eƂ̌덷elȉɂȂłeiKI
+  //
+  //   distance: _`̒S܂ł̋
+  //   radius: `̒Sł_܂ł̋
+  //   scale: _狗 1 ̈ʒuɂ钷 1 ̐̉ʏ̒ (f)
+  //
+  GLuint selectLevel(GLuint nl, const GLfloat *error, GLfloat distance, GLfloat radius, GLfloat scale)
+  {
+    // `̍łO̓_܂ł̋
+    const GLfloat depth(distance - radius);
+
+    // _`̒ɂ΍łׂiKg
+    if (depth <= 0.0f) return 0;
+
+    // iKeȂقǌ덷͑傫Ȃ
+    GLuint level(0);
+    while (level + 1 < nl && error[level + 1] * scale <= lodTolerance * depth) ++level;
+
+    return level;
+  }
+#endif
+
+#if USEMAP
   //
   // eNX`̍쐬
   //
@@ -230,7 +711,7 @@ namespace
     const GLfloat *amb, GLuint tex)
   {
     // eNX`IuWFNgɃeNX`蓖Ă
-    glBindTexture(GL_TEXTURE_2D, tex);
+    ggBindTexture(GL_TEXTURE_2D, tex);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, format, GL_UNSIGNED_BYTE, buffer);
 
     // eNX`͐`Ԃ
@@ -244,6 +725,89 @@ namespace
     // eNX`̋EFɑݒ肷
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, amb);
   }
+#else
+  //
+  // 쐬}bv
+  //
+  struct GeneratedMap
+  {
+    GgBundleEntry entry;
+    std::vector<GLubyte> data;
+  };
+
+#if HDRMAP
+  //
+  // x_̃eNX`̍쐬
+  //
+  void createTexture(const GLhalf *buffer, GLsizei width, GLsizei height,
+    const GLfloat *amb, GLuint tex, GeneratedMap &map)
+  {
+    // }bvoht@Cɕۑf[^
+    const GLubyte *const data(reinterpret_cast<const GLubyte *>(buffer));
+    map.data.assign(data, data + width * height * 3 * sizeof (GLhalf));
+
+    // }bvoht@C̖ڎ̍ڂ
+    memset(&map.entry, 0, sizeof map.entry);
+    map.entry.width = width;
+    map.entry.height = height;
+    map.entry.internal = GL_RGB16F;
+    map.entry.format = GL_RGB;
+    map.entry.type = GL_HALF_FLOAT;
+    map.entry.size = map.data.size();
+    std::copy(amb, amb + 4, map.entry.border);
+
+    // eNX`IuWFNgɃeNX`蓖Ă
+    ggBindTexture(GL_TEXTURE_2D, tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_HALF_FLOAT, buffer);
+
+    // eNX`͐`Ԃ
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    // EFg
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+    // eNX`̋EFɑݒ肷
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, amb);
+  }
+#else
+  //
+  // BC1 `ɈkeNX`̍쐬
+  //
+  void createCompressedTexture(const GLubyte *buffer, GLsizei width, GLsizei height, GLenum format,
+    const GLfloat *amb, GLuint tex, GeneratedMap &map)
+  {
+    // 摜 BC1 `Ɉk
+    map.data.resize(ggCompressBC1(buffer, width, height, format, nullptr));
+    ggCompressBC1(buffer, width, height, format, &map.data[0]);
+
+    // }bvoht@C̖ڎ̍ڂ
+    memset(&map.entry, 0, sizeof map.entry);
+    map.entry.width = width;
+    map.entry.height = height;
+    map.entry.internal = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    map.entry.size = map.data.size();
+    std::copy(amb, amb + 4, map.entry.border);
+
+    // eNX`IuWFNgɈkeNX`蓖Ă
+    ggBindTexture(GL_TEXTURE_2D, tex);
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, width, height, 0,
+      static_cast<GLsizei>(map.data.size()), &map.data[0]);
+
+    // eNX`͐`Ԃ
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    // EFg
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+
+    // eNX`̋EFɑݒ肷
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, amb);
+  }
+#endif
+#endif
 
 #if USEMAP
   //
@@ -291,6 +855,89 @@ namespace
     // ׂēǂݍݐ
     return status;
   }
+
+  //
+  // }bvoht@C̓ǂݍ
+  //
+  //   Œ@\̃eNX`̓eNX`zQƂłȂ̂Ōʂ̃eNX`ɓ]
+  //
+  bool loadBundle(const char *name, size_t count, const GLuint *imap, const GLuint *emap)
+  {
+    // }bvoht@CɃ}bv
+    const GgBundle bundle(name);
+
+    // ˏƓx}bvƊ}bvĂȂΎgȂ
+    if (bundle.count() != count * 2) return false;
+
+    // OˏƓx}bv, 㔼}bv
+    for (size_t i = 0; i < count; ++i)
+    {
+      bundle.loadTexture(static_cast<GLuint>(i), imap[i]);
+      bundle.loadTexture(static_cast<GLuint>(i + count), emap[i]);
+    }
+
+    return true;
+  }
+
+  //
+  // }bvoht@C̃}bveNX`zɓǂݍ
+  //
+  //   VF[_ŕ`Ƃ͕ˏƓx}bvƊ}bvꂼ̃eNX`zɈxɓ].
+  //   iarray, earray: ˏƓx}bvƊ}bṽeNX`z̊i[
+  //   iborder, eborder: }bvƂ̋EF̊i[
+  //
+  bool loadBundleArray(const char *name, size_t count, GLuint &iarray, GLuint &earray,
+    GLfloat (*iborder)[4], GLfloat (*eborder)[4])
+  {
+    // }bvoht@CɃ}bv
+    const GgBundle bundle(name);
+
+    // ˏƓx}bvƊ}bvĂȂΎgȂ
+    if (bundle.count() != count * 2) return false;
+
+    // OˏƓx}bv, 㔼}bv
+    iarray = bundle.loadArray(0, static_cast<GLuint>(count));
+    earray = bundle.loadArray(static_cast<GLuint>(count), static_cast<GLuint>(count));
+    if (iarray == 0 || earray == 0)
+    {
+      ggDeleteTextures(1, &iarray);
+      ggDeleteTextures(1, &earray);
+      iarray = earray = 0;
+      return false;
+    }
+
+    // }bvƂ̋EF
+    for (size_t i = 0; i < count; ++i)
+    {
+      std::copy(bundle.entry(static_cast<GLuint>(i)).border, bundle.entry(static_cast<GLuint>(i)).border + 4, iborder[i]);
+      std::copy(bundle.entry(static_cast<GLuint>(i + count)).border, bundle.entry(static_cast<GLuint>(i + count)).border + 4, eborder[i]);
+    }
+
+    return true;
+  }
+
+  //
+  // g}bvoht@CT
+  //
+  //   x_̂̂D悷.  hdr ɂꂪx_̃}bvǂi[.
+  //   ߂l: }bvoht@C (Ȃ nullptr)
+  //
+  const char *findBundle(size_t count, bool &hdr)
+  {
+    const char *const names[] = { hdrbundlename, bundlename };
+    for (int i = 0; i < 2; ++i)
+    {
+      // ˏƓx}bvƊ}bvĂȂΎgȂ
+      const GgBundle bundle(names[i]);
+      if (bundle.count() != count * 2) continue;
+
+      // x_̃}bvǂ
+      hdr = bundle.entry(0).type == GL_HALF_FLOAT;
+      return names[i];
+    }
+
+    return nullptr;
+  }
 #else
   //
   // l (Xorshift @)
@@ -379,7 +1026,7 @@ namespace
   //
   void smooth(const GLubyte *src, GLsizei width, GLsizei height, GLenum format,
     GLsizei xc, GLsizei yc, GLsizei xr, GLsizei yr, unsigned int samples,
-    GLubyte *dst, GLsizei size, const GLfloat *amb, GLfloat shi)
+    GLfloat *dst, GLsizei size, const GLfloat *amb, GLfloat shi)
   {
     // Tv[
     GLfloat (*const sampler)[3](new GLfloat[samples][3]);
@@ -422,9 +1069,9 @@ namespace
         if (qy <= 0.0f)
         {
           // ݒ肷
-          dst[id + 0] = GLubyte(ramb);
-          dst[id + 1] = GLubyte(gamb);
-          dst[id + 2] = GLubyte(bamb);
+          dst[id + 0] = ramb;
+          dst[id + 1] = gamb;
+          dst[id + 2] = bamb;
           continue;
         }
 
@@ -474,10 +1121,10 @@ namespace
           bsum += float(src[is + 0]);
         }
 
-        // ˏƓx}bv̉fl̕ς߂
-        dst[id + 0] = GLubyte(round(rsum / float(samples)));
-        dst[id + 1] = GLubyte(round(gsum / float(samples)));
-        dst[id + 2] = GLubyte(round(bsum / float(samples)));
+        // ˏƓx}bv̉fl̕ς߂ (ۂ߂ɕ_̂܂܎c)
+        dst[id + 0] = rsum / float(samples);
+        dst[id + 1] = gsum / float(samples);
+        dst[id + 2] = bsum / float(samples);
       }
     }
 
@@ -486,60 +1133,91 @@ namespace
     delete[] rsampler;
   }
 
+  //
+  // 摜eNX`쐬ĕۑ
+  //
+  void storeMap(const std::vector<GLfloat> &temp, GLsizei size, const char *prefix, int count,
+    const GLfloat *amb, GLuint tex, GeneratedMap &map)
+  {
+    // 8 bit Ɋۂ߂摜
+    std::vector<GLubyte> ldr(temp.size());
+    for (size_t i = 0; i < temp.size(); ++i)
+    {
+      ldr[i] = GLubyte(std::min(float(round(temp[i])), 255.0f));
+    }
+
+#if HDRMAP
+    // fl 0`1 ɐKĔx_ɕϊ (8 bit Ɋۂ߂ƂɎ[c)
+    std::vector<GLfloat> normalized(temp.size());
+    for (size_t i = 0; i < temp.size(); ++i) normalized[i] = temp[i] / 255.0f;
+    std::vector<GLhalf> hdr(temp.size());
+    ggFloatToHalf(&normalized[0], normalized.size(), &hdr[0]);
+
+    // x_̃eNX`쐬
+    createTexture(&hdr[0], size, size, amb, tex, map);
+#else
+    // BC1 `ɈkeNX`쐬
+    createCompressedTexture(&ldr[0], size, size, GL_RGB, amb, tex, map);
+#endif
+
+    // 쐬eNX`ۑ
+    std::stringstream name;
+    name << prefix << std::setfill('0') << std::setw(5) << std::right << count << ".tga";
+    strncpy(map.entry.name, name.str().c_str(), sizeof map.entry.name - 1);
+    ggSaveTga(size, size, 3, &ldr[0], name.str().c_str());
+  }
+
   //
   // ˏƓx}bv̍쐬
   //
-  bool createMap(const char *name, GLsizei diameter,
+  bool createMap(const char *name, GLsizei diameter, GLsizei resolution,
     GLuint imap, GLsizei isize, unsigned int isamples,
     GLuint emap, GLsizei esize, unsigned int esamples,
-    const GLfloat *amb, GLfloat shi)
+    const GLfloat *amb, GLfloat shi, GeneratedMap &imapdata, GeneratedMap &emapdata)
   {
     // 쐬eNX`̐
     static int count(0);
 
-    // ǂݍ񂾉摜̕ƍ, tH[}bg
+    // V摜̕ƍ, tH[}bg
     GLsizei width, height;
     GLenum format;
 
-    // V摜t@C̓ǂݍ
-    GLubyte const *const texture(ggLoadTga(name, &width, &height, &format));
+    // V摜t@C̃wb_ǂݍ
+    if (!ggLoadTgaHeader(name, &width, &height, &format)) return false;
+
+    // diameter, width, height ̍ŏlV̈̒aɂ
+    const GLsizei size(std::min(diameter, std::min(width, height)) / 2 * 2);
+
+    // ǂݍ񂾓V̈̑傫 (resolution Ȃ炻ȉɏk)
+    const GLsizei sky(resolution > 0 ? std::min(resolution, size) : size);
+
+    // V摜t@C璆̓V̈悾ǂݍ
+    GLubyte const *const texture(ggLoadTgaCrop(name, width / 2 - size / 2, height / 2 - size / 2, size, size,
+      sky, sky, &format));
 
     // 摜ǂݍ߂ȂΏI
     if (!texture) return false;
 
-    // ̉摜̒Sʒu
-    const GLsizei cx(width / 2), cy(height / 2);
-
-    // diameter, width, height ̍ŏl 1 / 2  radius ɂ
-    const GLsizei radius(std::min(diameter, std::min(width, height)) / 2);
+    // ǂݍ񂾓V̈̒SʒuƔa
+    const GLsizei cx(sky / 2), cy(sky / 2), radius(sky / 2);
 
     // ˏƓx}bv̈ꎞۑ
-    std::vector<GLubyte> itemp(isize * isize * 3);
+    std::vector<GLfloat> itemp(isize * isize * 3);
 
     // ˏƓx}bvpɕ
-    smooth(texture, width, height, format, cx, cy, radius, radius, isamples, &itemp[0], isize, amb, 1.0f);
+    smooth(texture, sky, sky, format, cx, cy, radius, radius, isamples, &itemp[0], isize, amb, 1.0f);
 
-    // ˏƓx}bṽeNX`쐬
-    createTexture(&itemp[0], isize, isize, GL_RGB, amb, imap);
-
-    // 쐬eNX`ۑ
-    std::stringstream imapname;
-    imapname << "irr" << std::setfill('0') << std::setw(5) << std::right << count << ".tga";
-    ggSaveTga(isize, isize, 3, &itemp[0], imapname.str().c_str());
+    // ˏƓx}bṽeNX`쐬ĕۑ
+    storeMap(itemp, isize, "irr", count, amb, imap, imapdata);
 
     // }bv̈ꎞۑ
-    std::vector<GLubyte> etemp(esize * esize * 3);
+    std::vector<GLfloat> etemp(esize * esize * 3);
 
     // }bvpɕ
-    smooth(texture, width, height, format, cx, cy, radius, radius, esamples, &etemp[0], esize, amb, shi);
+    smooth(texture, sky, sky, format, cx, cy, radius, radius, esamples, &etemp[0], esize, amb, shi);
 
-    // }bṽeNX`쐬
-    createTexture(&etemp[0], esize, esize, GL_RGB, amb, emap);
-
-    // 쐬eNX`ۑ
-    std::stringstream emapname;
-    emapname << "env" << std::setfill('0') << std::setw(5) << std::right << count << ".tga";
-    ggSaveTga(esize, esize, 3, &etemp[0], emapname.str().c_str());
+    // }bṽeNX`쐬ĕۑ
+    storeMap(etemp, esize, "env", count, amb, emap, emapdata);
 
     // ǂݍ񂾃f[^͂gȂ̂Ń
     delete[] texture;
@@ -551,10 +1229,75 @@ namespace
   }
 #endif
 
+  //
+  // ʂ̃eNX`eNX`z̃Cɕʂ
+  //
+  //   }bvoht@Cg킸ɃVF[_ŕ`Ƃ, ǂݍ񂾂쐬肵}bv
+  //   eNX`z. eNX`̑傫ĂȂ΍Ȃ.
+  //   count: eNX`̐
+  //   tex: ʂeNX`
+  //   hdr: x_̃}bvȂ true
+  //   border: eNX`Ƃ̋EF̊i[
+  //   ߂l: eNX`z̃eNX` (Ȃ 0)
+  //
+  GLuint copyToArray(size_t count, const GLuint *tex, bool hdr, GLfloat (*border)[4])
+  {
+    // eNX`z
+    GLuint array(0);
+
+    // eNX`ǂݏof[^
+    std::vector<GLfloat> data;
+
+    // eNX`̑傫
+    GLint width(0), height(0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      // eNX`̑傫ƋEF𒲂ׂ
+      ggBindTexture(GL_TEXTURE_2D, tex[i]);
+      GLint w, h;
+      glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+      glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+      glGetTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border[i]);
+
+      if (i == 0)
+      {
+        // ŏ̃eNX`̑傫ŃeNX`z̃mۂ
+        width = w;
+        height = h;
+        data.resize(width * height * 3);
+        glGenTextures(1, &array);
+        ggBindTexture(GL_TEXTURE_2D_ARRAY, array);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, hdr ? GL_RGB16F : GL_RGB8, width, height, static_cast<GLsizei>(count), 0,
+          GL_RGB, GL_FLOAT, nullptr);
+      }
+      else if (w != width || h != height)
+      {
+        std::cerr << "Error: Maps are not the same size. Can't make a texture array." << std::endl;
+        ggDeleteTextures(1, &array);
+        return 0;
+      }
+
+      // eNX`̓eǂݏoăCɓ]
+      glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_FLOAT, &data[0]);
+      ggBindTexture(GL_TEXTURE_2D_ARRAY, array);
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i), width, height, 1, GL_RGB, GL_FLOAT, &data[0]);
+    }
+
+    // eNX`͐`Ԃ, EFg (CƂ̋EF̓VF[_Ŏg)
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    if (count > 0) glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border[0]);
+
+    return array;
+  }
+
   //
   // ˏƓx}bvɎgeNX`jbg̐ݒ
   //
-  void irradiance()
+  void irradiance(bool hdr)
   {
     // eNX`Wɖ@xNgg
     glTexGeni(GL_S, GL_TEXTURE_GEN_MODE, GL_NORMAL_MAP);
@@ -564,17 +1307,31 @@ namespace
     glEnable(GL_TEXTURE_GEN_T);
     glEnable(GL_TEXTURE_GEN_R);
 
-    // ˏƓx}bv̒lグ Ce  Cb + Ct
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-    glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_ADD);          // Z
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_CONSTANT);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);   // Cb  GL_TEXTURE_ENV_COLOR  RGB l
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_TEXTURE);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_RGB, GL_SRC_COLOR);   // Ct  ˏƓx}bv̒l
+    if (hdr)
+    {
+      // x_̕ˏƓx}bv̒lɘIo Ce  Cb * Ct * 4
+      ggTexEnvi(GL_TEXTURE_ENV_MODE, GL_COMBINE);
+      ggTexEnvi(GL_COMBINE_RGB, GL_MODULATE);   // Z
+      ggTexEnvi(GL_SOURCE0_RGB, GL_CONSTANT);
+      ggTexEnvi(GL_OPERAND0_RGB, GL_SRC_COLOR); // Cb  GL_TEXTURE_ENV_COLOR  RGB l
+      ggTexEnvi(GL_SOURCE1_RGB, GL_TEXTURE);
+      ggTexEnvi(GL_OPERAND1_RGB, GL_SRC_COLOR); // Ct  ˏƓx}bv̒l
+      ggTexEnvf(GL_RGB_SCALE, 4.0f);            // ʂ 4 {
+    }
+    else
+    {
+      // ˏƓx}bv̒lグ Ce  Cb + Ct
+      ggTexEnvi(GL_TEXTURE_ENV_MODE, GL_COMBINE);
+      ggTexEnvi(GL_COMBINE_RGB, GL_ADD);        // Z
+      ggTexEnvi(GL_SOURCE0_RGB, GL_CONSTANT);
+      ggTexEnvi(GL_OPERAND0_RGB, GL_SRC_COLOR); // Cb  GL_TEXTURE_ENV_COLOR  RGB l
+      ggTexEnvi(GL_SOURCE1_RGB, GL_TEXTURE);
+      ggTexEnvi(GL_OPERAND1_RGB, GL_SRC_COLOR); // Ct  ˏƓx}bv̒l
+    }
 
     // eNX`W̕ϊsɕʃ}bsOp̕ϊsݒ肷
-    glMatrixMode(GL_TEXTURE);
-    glLoadMatrixf(paraboloid);
+    ggMatrixMode(GL_TEXTURE);
+    ggLoadMatrixf(paraboloid);
   }
 
   //
@@ -583,12 +1340,12 @@ namespace
   void diffuse()
   {
     // ̂̐Fi_F̕ԒljɑOCŋ߂ˌx Cd  Cv * Ce
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-    glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_MODULATE);     // Z
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_PRIMARY_COLOR);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);   // Cv  _F̕Ԓl
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_PREVIOUS);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_RGB, GL_SRC_COLOR);   // Ce  グˏƓx (OC)
+    ggTexEnvi(GL_TEXTURE_ENV_MODE, GL_COMBINE);
+    ggTexEnvi(GL_COMBINE_RGB, GL_MODULATE);     // Z
+    ggTexEnvi(GL_SOURCE0_RGB, GL_PRIMARY_COLOR);
+    ggTexEnvi(GL_OPERAND0_RGB, GL_SRC_COLOR);   // Cv  _F̕Ԓl
+    ggTexEnvi(GL_SOURCE1_RGB, GL_PREVIOUS);
+    ggTexEnvi(GL_OPERAND1_RGB, GL_SRC_COLOR);   // Ce  グˏƓx (OC)
   }
 
   //
@@ -605,18 +1362,39 @@ namespace
     glEnable(GL_TEXTURE_GEN_R);
 
     // }bv̒lƑOCŋ߂gUˌxʔˌWŔz C  Ct * Cs + Cd * (1 - Cs)
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_COMBINE);
-    glTexEnvi(GL_TEXTURE_ENV, GL_COMBINE_RGB, GL_INTERPOLATE);  // 
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE0_RGB, GL_TEXTURE);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND0_RGB, GL_SRC_COLOR);   // Ct  }bv̒l
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE1_RGB, GL_PREVIOUS);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND1_RGB, GL_SRC_COLOR);   // Cd  gUˌx (OC)
-    glTexEnvi(GL_TEXTURE_ENV, GL_SOURCE2_RGB, GL_CONSTANT);
-    glTexEnvi(GL_TEXTURE_ENV, GL_OPERAND2_RGB, GL_SRC_COLOR);   // Cs  ʔˌW
+    ggTexEnvi(GL_TEXTURE_ENV_MODE, GL_COMBINE);
+    ggTexEnvi(GL_COMBINE_RGB, GL_INTERPOLATE);  // 
+    ggTexEnvi(GL_SOURCE0_RGB, GL_TEXTURE);
+    ggTexEnvi(GL_OPERAND0_RGB, GL_SRC_COLOR);   // Ct  }bv̒l
+    ggTexEnvi(GL_SOURCE1_RGB, GL_PREVIOUS);
+    ggTexEnvi(GL_OPERAND1_RGB, GL_SRC_COLOR);   // Cd  gUˌx (OC)
+    ggTexEnvi(GL_SOURCE2_RGB, GL_CONSTANT);
+    ggTexEnvi(GL_OPERAND2_RGB, GL_SRC_COLOR);   // Cs  ʔˌW
 
     // eNX`W̕ϊsɕʃ}bsOp̕ϊsݒ肷
-    glMatrixMode(GL_TEXTURE);
-    glLoadMatrixf(paraboloid);
+    ggMatrixMode(GL_TEXTURE);
+    ggLoadMatrixf(paraboloid);
+  }
+
+  //
+  // ItXN[̃x`}[ÑJ̌oH
+  //
+  //   frame: t[ԍ, frames: t[
+  //   `̎Ȃ߂Âė̂, ڍדx̒iKʂ؂ւ
+  //
+  void benchmarkView(int frame, int frames, Window &window)
+  {
+    // oḦʒu (0`2)
+    const GLfloat t(6.2831853f * GLfloat(frame) / GLfloat(frames));
+
+    // ]S܂ł̋ 3`12
+    const GLfloat distance(7.5f - 4.5f * cos(t));
+
+    // c܂ɈȂ班㉺ɌX
+    const GgQuaternion q(ggRotateQuaternion(1.0f, 0.0f, 0.0f, 0.3f * sin(2.0f * t))
+      * ggRotateQuaternion(0.0f, 1.0f, 0.0f, t));
+
+    window.setView(0.0f, 0.0f, -distance, q);
   }
 
   //
@@ -632,8 +1410,60 @@ namespace
 //
 // CvO
 //
-int main()
+int main(int argc, char *argv[])
 {
+  // ItXN[ŕ`t[ (0 ȂEBhEJđΘbIɕ`)
+  int benchmark(0);
+
+  // ItXN[ŕ`摜ۑԊu (0 ȂۑȂ)
+  int interval(0);
+
+  // t[̌vʂۑ CSV t@C (nullptr ȂۑȂ)
+  const char *profile(nullptr);
+
+  // CX^VOŕ``̐ (0 Ȃ`)
+  GLsizei instances(0);
+
+  // ωȂĂt[`Ȃ true (ItXN[ł͏ɖt[`)
+  bool continuous(false);
+
+  // I𑜓xŃV[` GPU Ԃ̖ڕW (~b, 0 Ȃkɕ`)
+  GLfloat budget(0.0f);
+
+  // R}hC̉
+  for (int arg = 1; arg < argc; ++arg)
+  {
+    if (strcmp(argv[arg], "-b") == 0 && arg + 1 < argc)
+    {
+      benchmark = atoi(argv[++arg]);
+    }
+    else if (strcmp(argv[arg], "-o") == 0 && arg + 1 < argc)
+    {
+      interval = atoi(argv[++arg]);
+    }
+    else if (strcmp(argv[arg], "-p") == 0 && arg + 1 < argc)
+    {
+      profile = argv[++arg];
+    }
+    else if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc)
+    {
+      instances = std::min(std::max(atoi(argv[++arg]), 0), int(maxInstances));
+    }
+    else if (strcmp(argv[arg], "-c") == 0)
+    {
+      continuous = true;
+    }
+    else if (strcmp(argv[arg], "-r") == 0 && arg + 1 < argc)
+    {
+      budget = GLfloat(atof(argv[++arg]));
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [-b frames] [-o interval] [-p profile.csv] [-n instances] [-c] [-r budget_ms]" << std::endl;
+      return 1;
+    }
+  }
+
   // GLFW 
   if (glfwInit() == GL_FALSE)
   {
@@ -646,7 +1476,13 @@ int main()
   atexit(cleanup);
 
   // EBhE쐬
-  Window window("Irradiance Mapping", 960, 540);
+  Window window("Irradiance Mapping", 960, 540, benchmark > 0);
+
+  // EBhEɕ\Ƃ͑Ȃǂŕ\ςƂ`
+  window.setOnDemand(benchmark == 0 && !continuous);
+
+  // ڕW GPU Ԃw肵V[kĕ`ăEBhȆ傫Ɋg傷
+  window.setBudget(budget);
 
   // OpenGL ̏ݒ
   glClearColor(0.3f, 0.5f, 0.8f, 0.0f);
@@ -658,36 +1494,121 @@ int main()
   // Aet𖳌ɂ
   glDisable(GL_LIGHTING);
 
-  // eNX`
+  // _F͎Op`̍Ō̒_̐Fg (̃^C̐FɎg. `͒_FȂ̂ŉeȂ)
+  glShadeModel(GL_FLAT);
+
+#if USEMAP
+  // x_̃}bvȂ true
+  bool hdr(false);
+
+  // }bvoht@C (x_̂̂D悷. ȂΌX̃t@Cǂݍ)
+  const char *const bundle(findBundle(mapcount, hdr));
+#else
+  // x_ō쐬邩
+  const bool hdr(HDRMAP != 0);
+#endif
+
+  // ˏƓx}bsÕVF[_ (쐬łȂ΃eNX`ŕ`)
+#if USESHADER
+  IrradianceShader irradianceShader("irradiance.vert", "irradiance.frag", hdr);
+  IrradianceShader *shader(irradianceShader.get() != 0 ? &irradianceShader : nullptr);
+#else
+  IrradianceShader *shader(nullptr);
+#endif
+
+  // eNX`Ŏg}bvƂ̃eNX`
   GLuint imap[mapcount], emap[mapcount];
+  std::fill(imap, imap + mapcount, 0);
+  std::fill(emap, emap + mapcount, 0);
+
+  // VF[_ŎgׂẴ}bvCɕׂeNX`zƃ}bvƂ̋EF
+  GLuint iarray(0), earray(0);
+  GLfloat iborder[mapcount][4], eborder[mapcount][4];
+
+  // eNX`̓ǂݍ
+#if USEMAP
+  // VF[_ŕ`Ȃ}bvoht@CeNX`zɈxɓ]
+  if (!shader || !bundle || !loadBundleArray(bundle, mapcount, iarray, earray, iborder, eborder))
+  {
+    // }bvoht@C΃}bvƂ̃eNX`ɓ], ȂΌX̃t@Cǂݍ
+    glGenTextures(mapcount, imap);
+    glGenTextures(mapcount, emap);
+    if (!bundle || !loadBundle(bundle, mapcount, imap, emap))
+    {
+      for (size_t i = 0; i < mapcount; ++i)
+      {
+        loadMap(irrmaps[i], envmaps[i], imap[i], emap[i]);
+      }
+    }
+  }
+#else
   glGenTextures(mapcount, imap);
   glGenTextures(mapcount, emap);
 
-  // eNX`̓ǂݍ
+  // 쐬}bv
+  std::vector<GeneratedMap> imapdata(mapcount), emapdata(mapcount);
+
   for (size_t i = 0; i < mapcount; ++i)
   {
-#if USEMAP
-    loadMap(irrmaps[i], envmaps[i], imap[i], emap[i]);
-#else
-    createMap(skymaps[i], skysize, imap[i], imapsize, isamples, emap[i], emapsize, esamples, ambient, shininess);
+    createMap(skymaps[i], skysize, skyresolution, imap[i], imapsize, isamples, emap[i], emapsize, esamples,
+      ambient, shininess, imapdata[i], emapdata[i]);
+  }
+
+  // 쐬}bvˏƓx}bv, }bv̏Ƀ}bvoht@Cɕۑ
+  std::vector<GgBundleEntry> entry;
+  std::vector<const GLvoid *> data;
+  for (size_t i = 0; i < mapcount; ++i)
+  {
+    entry.push_back(imapdata[i].entry);
+    data.push_back(&imapdata[i].data[0]);
+  }
+  for (size_t i = 0; i < mapcount; ++i)
+  {
+    entry.push_back(emapdata[i].entry);
+    data.push_back(&emapdata[i].data[0]);
+  }
+  ggSaveBundle(bundlename, static_cast<GLuint>(entry.size()), &entry[0], &data[0]);
 #endif
+
+  // VF[_ŕ`̂ɃeNX`z񂪂Ȃ΃}bvƂ̃eNX`
+  if (shader && iarray == 0)
+  {
+    iarray = copyToArray(mapcount, imap, hdr, iborder);
+    earray = copyToArray(mapcount, emap, hdr, eborder);
+
+    // eNX`z񂪍Ȃ΃eNX`ŕ`
+    if (iarray == 0 || earray == 0)
+    {
+      std::cerr << "Warning: Can't make map texture arrays. Drawing without the irradiance shader." << std::endl;
+      shader = nullptr;
+    }
   }
 
   // ˏƓx}bv̂グɎgeNX`jbg̐ݒ
-  glActiveTexture(GL_TEXTURE0);
+  ggActiveTexture(GL_TEXTURE0);
   glEnable(GL_TEXTURE_2D);
-  irradiance();
+  irradiance(hdr);
 
   // ˏƓx}bv̂グɎgeNX`jbg̐ݒ
-  glActiveTexture(GL_TEXTURE1);
+  ggActiveTexture(GL_TEXTURE1);
   glEnable(GL_TEXTURE_2D);
   diffuse();
 
   // }bv̉ZɎgeNX`jbg̐ݒ
-  glActiveTexture(GL_TEXTURE2);
+  ggActiveTexture(GL_TEXTURE2);
   glEnable(GL_TEXTURE_2D);
   reflection();
 
+  // VF[_ŕ`Ƃ͕ˏƓx}bvjbg 0, }bvjbg 1 ̃eNX`zŎQƂ
+  // (}bv̓CőIԂ̂, }bv؂ւĂȂ)
+  if (shader)
+  {
+    ggActiveTexture(GL_TEXTURE0);
+    ggBindTexture(GL_TEXTURE_2D_ARRAY, iarray);
+    ggActiveTexture(GL_TEXTURE1);
+    ggBindTexture(GL_TEXTURE_2D_ARRAY, earray);
+  }
+
   // ގf[^
   GLuint ng;
   GLuint (*group)[2];
@@ -697,14 +1618,177 @@ int main()
   GLuint nv;
   GLfloat (*pos)[3], (*norm)[3];
 
+#if USELOD
+  // ڍדx̒iKƂ̎Op`
+  GLuint nl, nf;
+  GLfloat *error;
+  GLuint (*face)[3];
+
+  // `f[^ǂݍŏڍדx̒iK
+  ggLoadObj(filename, ng, group, amb, diff, spec, shi, nv, pos, norm, nl, error, nf, face, false);
+
+  // ׂĂ̒iK̎Op`̃CfbNXobt@ɓ GPU ɓ]Ă
+  const GgElements shape(nv, pos, norm, nf, face);
+#else
   // `f[^̓ǂݍ
   ggLoadObj(filename, ng, group, amb, diff, spec, shi, nv, pos, norm, false);
 
-  // EBhEJĂԌJԂ
-  while (window.shouldClose() == GL_FALSE)
+  // `f[^ GPU ɓ]Ă
+  const GgTriangles shape(nv, pos, norm);
+#endif
+
+  // ` AABB
+  GLfloat lower[] = { FLT_MAX, FLT_MAX, FLT_MAX }, upper[] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+  for (GLuint v = 0; v < nv; ++v)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      lower[k] = std::min(lower[k], pos[v][k]);
+      upper[k] = std::max(upper[k], pos[v][k]);
+    }
+  }
+
+  // `̒S (Kɓǂݍ񂾂̂Ō_Ƃ͌Ȃ AABB ̒Sg)
+  const GLfloat center[] =
+  {
+    (lower[0] + upper[0]) * 0.5f, (lower[1] + upper[1]) * 0.5f, (lower[2] + upper[2]) * 0.5f, 1.0f
+  };
+
+  // `̒Sł_܂ł̋
+  GLfloat radius(0.0f);
+  for (GLuint v = 0; v < nv; ++v)
+  {
+    const GLfloat dx(pos[v][0] - center[0]), dy(pos[v][1] - center[1]), dz(pos[v][2] - center[2]);
+    const GLfloat r(sqrt(dx * dx + dy * dy + dz * dz));
+    if (r > radius) radius = r;
+  }
+
+  // Œ@\̒_zɂ_obt@IuWFNgg
+  attachArrays(shape);
+
+  // ̌`쐬 GPU ɓ]Ă
+  GLuint floorvao, floorbuf[2];
+  glGenVertexArrays(1, &floorvao);
+  glGenBuffers(2, floorbuf);
+  const GLsizei floorcount(createFloor(5, -1.0f, floorvao, floorbuf));
+
+  // CX^VÕVF[_ (CX^X̐w肵ăVF[_ŕ`Ƃ)
+  InstancedShader *instanced(nullptr);
+  if (instances > 0 && shader)
+  {
+    instanced = new InstancedShader("instanced.vert", "irradiance.frag", hdr);
+    if (instanced->get() == 0)
+    {
+      delete instanced;
+      instanced = nullptr;
+    }
+  }
+
+  // CX^XƂ̃f[^ GPU ɓ]Ă
+  GLuint instancevao(0), instancebuf(0);
+  std::vector<Instance> instance;
+#if USECULLING
+  // CX^X AABB ̊KwƉ̃CX^X̔ԍƃf[^
+  GgBvh bvh;
+  std::vector<GLuint> visible;
+  std::vector<Instance> visibleInstance;
+
+  // ȂCX^X̐̍vƃJOt[
+  double culled(0.0);
+  unsigned long cullFrames(0);
+#endif
+  if (instanced)
+  {
+    glGenVertexArrays(1, &instancevao);
+    glGenBuffers(1, &instancebuf);
+    createInstances(instances, radius, -1.0f, shape, *instanced, instancevao, instancebuf, instance);
+
+#if USECULLING
+    // CX^X AABB ̊Kw
+    std::vector<GLfloat> bmin(instances * 3), bmax(instances * 3);
+    for (GLsizei i = 0; i < instances; ++i)
+      instanceBounds(instance[i], lower, upper, &bmin[i * 3], &bmax[i * 3]);
+    bvh.build(instances, reinterpret_cast<const GLfloat (*)[3]>(&bmin[0]), reinterpret_cast<const GLfloat (*)[3]>(&bmax[0]));
+    visible.resize(instances);
+    visibleInstance.resize(instances);
+#endif
+
+    // `Op`̑\
+    GLuint count(0);
+    for (GLuint g = 0; g < ng; ++g) count += group[g][1] / 3;
+    std::cout << "Instances: " << instances << " (" << double(count) * instances << " triangles)" << std::endl;
+  }
+  else if (instances > 0)
+  {
+    std::cerr << "Warning: Instancing needs the irradiance shader. Drawing a single object." << std::endl;
+  }
+
+  // t[̔񓯊Lv`
+  GgCapture capture;
+
+  // ۑt[
+  int frames(0);
+
+  // Ԃ̃LbVgݒ̂ OpenGL ɑ̂Əȗ̂̐
+  unsigned long stateIssued(0), stateElided(0), stateFrames(0);
+
+  // v̑Oɕ`t[ (VF[_̖|ȂǏ񂾂̏v珜)
+  const int warmup(10);
+
+  // ItXN[ŕ`t[ (vn߂܂ł͕)
+  int frame(-warmup);
+
+  // ԂƂ CPU Ԃ GPU Ԃ̌v (ItXN[ȂSt[̓v)
+  GgProfiler profiler(benchmark > 0 ? benchmark : 600);
+
+  // ItXN[Ōvn߂
+  std::chrono::steady_clock::time_point start;
+
+  // EBhEJĂ (ItXN[Ȃw肵t[) JԂ
+  while (benchmark > 0 ? frame < benchmark : window.shouldClose() == GL_FALSE)
   {
+    // `vɂĂΕ`Kv܂ő҂ (҂Ԃ̓t[̌vɊ܂߂Ȃ)
+    window.waitEvents();
+
+    // ItXN[Ȃ猈܂oHŃJ𓮂
+    if (benchmark > 0)
+    {
+      // ŏ̃t[܂ł̌vl͎̂Ă
+      if (frame == 0)
+      {
+        glFinish();
+        profiler.reset();
+        start = std::chrono::steady_clock::now();
+      }
+      benchmarkView(std::max(frame, 0), benchmark, window);
+    }
+
+    // t[̌vJn
+    profiler.frame();
+
+    // I𑜓xȂ琔t[ÕV[̕` GPU Ԃŏk𒲐, ڕWƂƂɋL^
+    //   kɂȂg̎Ԃ͕ēn
+    if (window.getBudget() > 0.0f)
+    {
+      const double upscaleTime(profiler.getGpuTime("upscale"));
+      const double renderTime(profiler.getGpuTime("render"));
+      if (upscaleTime > 0.0 && renderTime > upscaleTime)
+        window.adjustScale(renderTime - upscaleTime, upscaleTime);
+      else
+        window.adjustScale(renderTime);
+      profiler.record("budget (ms)", window.getBudget());
+      profiler.record("scale", window.getRenderScale());
+    }
+
+    profiler.begin("frame");
+
+    // V[̕` (EBhȄg܂) ̌vJn
+    profiler.begin("render");
+
     // EBhE
+    profiler.begin("clear");
     window.clear();
+    profiler.end();
 
     // eNX`̑I
     const int select(window.getSelection() % mapcount);
@@ -713,36 +1797,184 @@ int main()
     GLfloat brightness[4];
     window.getBrightness(brightness);
 
-    // ˏƓx}bv̂グ
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, imap[select]);
-    glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, brightness);
+    // x_̃}bvł͖邳Io (1`4 {) ƂĎg
+    if (hdr) brightness[0] = brightness[1] = brightness[2] = (1.0f + 3.0f * brightness[0]) * 0.25f;
 
-    // gUˌx̎Zo
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, imap[select]);
+    // fr[ϊs (_̈ړƃgbN{[ɂ])
+    const GgMatrix mw(ggTranslate(window.getPosition()) * GgMatrix(window.getTb()));
 
-    // }bsO
-    glActiveTexture(GL_TEXTURE2);
-    glBindTexture(GL_TEXTURE_2D, emap[select]);
+    // }bv̌ƕϊs̐ݒ
+    profiler.begin("map bind");
+    if (shader)
+    {
+      // g}bv̓eNX`z̃CőI
+      shader->use();
+      shader->setLayer(select, iborder[select], eborder[select]);
 
-    // fr[ϊs̐ݒ
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+      // 邳ƕϊsݒ肷
+      shader->setLightAmbient(brightness);
+      shader->loadMatrix(window.getMp(), mw);
 
-    // _̈ړ
-    glTranslatef(window.getPosition()[0], window.getPosition()[1], window.getPosition()[2]);
+      // CX^VÕVF[_ɂ̂ݒ肷
+      if (instanced)
+      {
+        instanced->use();
+        instanced->setLayer(select, iborder[select], eborder[select]);
+        instanced->setLightAmbient(brightness);
+        instanced->loadMatrix(window.getMp(), mw);
+      }
+    }
+    else
+    {
+      // ˏƓx}bv̂グ
+      ggActiveTexture(GL_TEXTURE0);
+      ggBindTexture(GL_TEXTURE_2D, imap[select]);
+      ggTexEnvfv(GL_TEXTURE_ENV_COLOR, brightness);
+
+      // gUˌx̎Zo
+      ggActiveTexture(GL_TEXTURE1);
+      ggBindTexture(GL_TEXTURE_2D, imap[select]);
+
+      // }bsO
+      ggActiveTexture(GL_TEXTURE2);
+      ggBindTexture(GL_TEXTURE_2D, emap[select]);
+
+      // fr[ϊs̐ݒ
+      ggMatrixMode(GL_MODELVIEW);
+      ggLoadMatrixf(mw.get());
+    }
+    profiler.end();
 
-    // gbN{[ɂ]
-    glMultMatrixf(window.getTb());
+    // `CX^X̐
+    GLsizei count(instances);
+#if USECULLING
+    if (instanced)
+    {
+      // ƌCX^XI, ̃f[^l߂ē]
+      profiler.begin("cull");
+      count = bvh.cull(window.getMp() * mw, &visible[0]);
+      for (GLsizei i = 0; i < count; ++i) visibleInstance[i] = instance[visible[i]];
+      glBindBuffer(GL_ARRAY_BUFFER, instancebuf);
+      glBufferData(GL_ARRAY_BUFFER, instances * sizeof (Instance), nullptr, GL_STREAM_DRAW);
+      if (count > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof (Instance), &visibleInstance[0]);
+      glBindBuffer(GL_ARRAY_BUFFER, 0);
+      culled += instances - count;
+      ++cullFrames;
+      profiler.end();
+    }
+#endif
 
     // V[̕`
-    scene(ng, group, diff, spec, nv, pos, norm);
+    profiler.begin("scene");
+    if (instanced)
+    {
+      // CX^VOł͏ڍדx؂ւɍłׂiKŕ`
+      instancedScene(ng, group, count, instancevao, *instanced);
+    }
+    else
+    {
+#if USELOD
+      // _`̒S܂ł̋Ǝۂɕ`ʂ̑傫ŏڍדx̒iKI (I𑜓x̏k|)
+      GLfloat c[4];
+      mw.projection(c, center);
+      const GLfloat distance(sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]));
+      const GLuint level(selectLevel(nl, error, distance, radius, window.getScale() * window.getRenderScale()));
+
+      // I񂾒iK͕`̌v𗐂Ȃ悤ɂ̏ŕ\, vt@C̓vɉ
+      profiler.record("lod", level);
+
+      scene(ng, group + level * ng, diff, spec, shape, shader);
+#else
+      scene(ng, group, diff, spec, shape, shader);
+#endif
+    }
+    profiler.end();
 
     // ̕`
-    floor(5, -1.0f);
+    profiler.begin("floor");
+    floor(floorvao, floorcount, shader);
+    profiler.end();
+
+    // I𑜓xȂkĕ`摜EBhȆ傫Ɋg傷
+    profiler.begin("upscale");
+    window.upscale();
+    profiler.end();
+
+    // V[̕`̌vI
+    profiler.end();
+
+    // ItXN[Ȃw肵ԊuŃt[ۑ
+    if (benchmark > 0)
+    {
+      if (frame >= 0 && interval > 0 && frame % interval == 0)
+      {
+        std::stringstream benchname;
+        benchname << "bench" << std::setfill('0') << std::setw(5) << std::right << frame << ".tga";
+        capture.capture(benchname.str().c_str());
+      }
+      ++frame;
+    }
+
+    // ^撆Ȃt[ۑ
+    if (window.isRecording())
+    {
+      std::stringstream capname;
+      capname << "cap" << std::setfill('0') << std::setw(5) << std::right << frames++ << ".tga";
+      capture.capture(capname.str().c_str());
+    }
+
+    // ̃t[̏Ԃ̐ݒ̐Wv
+    GLuint issued, elided;
+    ggGetStateCount(issued, elided);
+    stateIssued += issued;
+    stateElided += elided;
+    ++stateFrames;
 
     // J[obt@ւăCxgo
+    profiler.begin("swap");
     window.swapBuffers();
+    profiler.end();
+
+    // t[̌vI
+    profiler.end();
+  }
+
+  // ItXN[ŕ`Ƃ͕`̊҂ăt[[g\
+  if (benchmark > 0)
+  {
+    glFinish();
+    const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+    std::cout << "Benchmark: " << benchmark << " frames in " << std::fixed << std::setprecision(3)
+      << elapsed.count() << " s (" << std::setprecision(1) << benchmark / elapsed.count() << " fps)" << std::endl;
+  }
+
+  // ԂƂ CPU Ԃ GPU Ԃ\
+  profiler.report();
+  if (profile) profiler.save(profile);
+
+#if USECULLING
+  // 1 t[̌ȂCX^X̊\ (JO CPU Ԃ cull ̋)
+  if (cullFrames > 0)
+  {
+    std::cout << "Frustum culling: " << std::fixed << std::setprecision(1)
+      << 100.0 * culled / (double(instances) * cullFrames) << "% of " << instances << " instances culled per frame" << std::endl;
+  }
+#endif
+
+  // CX^VOɎgIuWFNg폜 (Ԃ̃LbVɎcȂ悤ɌĂ폜)
+  if (instanced)
+  {
+    ggBindVertexArray(0);
+    glDeleteBuffers(1, &instancebuf);
+    glDeleteVertexArrays(1, &instancevao);
+    delete instanced;
+  }
+
+  // 1 t[̏Ԃ̐ݒ̐\
+  if (stateFrames > 0)
+  {
+    std::cout << "GL state calls per frame: " << std::fixed << std::setprecision(1)
+      << double(stateIssued) / stateFrames << " issued, "
+      << double(stateElided) / stateFrames << " elided" << std::endl;
   }
 }
@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <iostream>
+
+// ⏕vO
+#include "gg.h"
+using namespace gg;
+
+//
+// g̕\
+//
+static int usage(const char *command)
+{
+  std::cerr << "Usage: " << command << " [-a alignment] [-c] output.ggb input.tga ..." << std::endl;
+  return 1;
+}
+
+//
+// TGA t@C܂Ƃ߂ă}bvoht@C
+//
+int main(int argc, char *argv[])
+{
+  // 摜f[^̐擪̃oCgE
+  GLuint alignment(4096);
+
+  // RGB ̉摜 BC1 `ɈkȂ true
+  bool compress(false);
+
+  // IvV̉
+  int arg(1);
+  while (arg < argc && argv[arg][0] == '-')
+  {
+    if (strcmp(argv[arg], "-a") == 0 && arg + 1 < argc)
+    {
+      alignment = static_cast<GLuint>(atoi(argv[arg + 1]));
+      arg += 2;
+    }
+    else if (strcmp(argv[arg], "-c") == 0)
+    {
+      compress = true;
+      ++arg;
+    }
+    else
+    {
+      return usage(argv[0]);
+    }
+  }
+
+  // o̓t@CƓ̓t@CȂΏI
+  if (argc - arg < 2) return usage(argv[0]);
+  const char *const output(argv[arg++]);
+
+  // ڎƉ摜f[^
+  std::vector<GgBundleEntry> entry;
+  std::vector<const GLvoid *> data;
+
+  // ̓t@Cɓǂݍ
+  bool status(true);
+  for (; arg < argc; ++arg)
+  {
+    // 摜̕ƍ, tH[}bg
+    GLsizei width, height;
+    GLenum format;
+
+    // 摜ǂݍ
+    const GLubyte *const image(ggLoadTga(argv[arg], &width, &height, &format));
+
+    // ǂݍ߂ȂI
+    if (image == nullptr)
+    {
+      status = false;
+      break;
+    }
+
+    // 1 f̃oCgƃeNX`̓tH[}bg
+    const unsigned int depth(format == GL_RED ? 1 : format == GL_RG ? 2 : format == GL_BGR ? 3 : 4);
+    static const GLenum internal[] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+
+    // ڎ̍ڂ
+    GgBundleEntry e;
+    memset(&e, 0, sizeof e);
+    const char *const slash(strrchr(argv[arg], '/'));
+    strncpy(e.name, slash ? slash + 1 : argv[arg], sizeof e.name - 1);
+    e.width = width;
+    e.height = height;
+    e.internal = internal[depth - 1];
+    e.format = format;
+    e.type = GL_UNSIGNED_BYTE;
+    e.size = width * height * depth;
+
+    // ̉f̐FEFɂ
+    e.border[0] = image[depth >= 3 ? 2 : 0] / 255.0f;
+    e.border[1] = image[depth >= 2 ? 1 : 0] / 255.0f;
+    e.border[2] = image[0] / 255.0f;
+    e.border[3] = depth == 4 ? image[3] / 255.0f : 1.0f;
+
+    // RGB ̉摜 BC1 `Ɉk
+    if (compress && depth == 3)
+    {
+      e.size = ggCompressBC1(image, width, height, format, nullptr);
+      GLubyte *const block(new GLubyte[static_cast<size_t>(e.size)]);
+      ggCompressBC1(image, width, height, format, block);
+      delete[] image;
+
+      // kf[^ format  0 ɂ
+      e.internal = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+      e.format = 0;
+      e.type = 0;
+
+      entry.push_back(e);
+      data.push_back(block);
+      continue;
+    }
+
+    entry.push_back(e);
+    data.push_back(image);
+  }
+
+  // }bvoht@Cɕۑ
+  if (status) status = ggSaveBundle(output, static_cast<GLuint>(entry.size()), &entry[0], &data[0], alignment);
+
+  // ǂݍ񂾉摜
+  for (std::vector<const GLvoid *>::const_iterator it = data.begin(); it != data.end(); ++it)
+  {
+    delete[] static_cast<const GLubyte *>(*it);
+  }
+
+  return status ? 0 : 1;
+}
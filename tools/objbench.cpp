@@ -0,0 +1,249 @@
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#if defined(_WIN32)
+#  define NOMINMAX
+#  include <windows.h>
+#  include <psapi.h>
+#  pragma comment(lib, "psapi.lib")
+#else
+#  include <sys/resource.h>
+#endif
+
+// ⏕vO
+#include "gg.h"
+using namespace gg;
+
+//
+// g̕\
+//
+static int usage(const char *command)
+{
+  std::cerr << "Usage: " << command << " [-n repeat] [-t threads] [-g size] [-c] [-i] [-o] [-l] file.obj" << std::endl;
+  std::cerr << "  -g size: generate a scan-like grid of 2 * size * size triangles into file.obj" << std::endl;
+  std::cerr << "  -c: read through the mesh cache file.obj.ggm (written by the first repeat if stale)" << std::endl;
+  std::cerr << "  -i: load indexed (deduplicated) vertices" << std::endl;
+  std::cerr << "  -o: optimize the triangle and vertex order of indexed loads (with -c, stored in file.obj.ggi)" << std::endl;
+  std::cerr << "  -l: build the level of detail chain of indexed loads (with -c, stored in file.obj.ggl)" << std::endl;
+  return 1;
+}
+
+//
+// ő̏풓 (MB) 𒲂ׂ
+//
+static double peakMegabytes()
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof counters)) return 0.0;
+  return double(counters.PeakWorkingSetSize) / 1048576.0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+#  if defined(__APPLE__)
+  return double(usage.ru_maxrss) / 1048576.0;
+#  else
+  return double(usage.ru_maxrss) / 1024.0;
+#  endif
+#endif
+}
+
+//
+// OXL̂悤Ȋiq̌` OBJ t@C
+//
+static bool generate(const char *name, int size)
+{
+  // t@CJ
+  FILE *const file(fopen(name, "wb"));
+  if (!file)
+  {
+    std::cerr << "Error: Can't open file: " << name << std::endl;
+    return false;
+  }
+
+  // _ʒuƖ@ (N̂)
+  for (int j = 0; j <= size; ++j)
+  {
+    for (int i = 0; i <= size; ++i)
+    {
+      const double x(double(i) / size - 0.5), z(double(j) / size - 0.5);
+      const double y(0.05 * sin(x * 40.0) * cos(z * 30.0));
+      fprintf(file, "v %.6f %.6f %.6f\n", x, y, z);
+    }
+  }
+  for (int j = 0; j <= size; ++j)
+  {
+    for (int i = 0; i <= size; ++i)
+    {
+      const double x(double(i) / size - 0.5), z(double(j) / size - 0.5);
+      const double nx(-2.0 * cos(x * 40.0) * cos(z * 30.0)), nz(1.5 * sin(x * 40.0) * sin(z * 30.0));
+      const double l(sqrt(nx * nx + 1.0 + nz * nz));
+      fprintf(file, "vn %.6f %.6f %.6f\n", nx / l, 1.0 / l, nz / l);
+    }
+  }
+
+  // Op`
+  fprintf(file, "s 1\n");
+  for (int j = 0; j < size; ++j)
+  {
+    for (int i = 0; i < size; ++i)
+    {
+      const int a(j * (size + 1) + i + 1), b(a + 1), c(a + size + 1), d(c + 1);
+      fprintf(file, "f %d//%d %d//%d %d//%d\n", a, a, c, c, b, b);
+      fprintf(file, "f %d//%d %d//%d %d//%d\n", b, b, c, c, d, d);
+    }
+  }
+
+  fclose(file);
+  return true;
+}
+
+//
+// OBJ t@C̓ǂݍݑxv
+//
+int main(int argc, char *argv[])
+{
+  // v񐔂ƍ쐬iq̕
+  int repeat(3), size(0);
+
+  // ǂݍ݂ɎgXbh (0 Ȃ玩)
+  unsigned int threads(0);
+
+  // bVLbVgǂ
+  bool cache(false);
+
+  // CfbNXgǂƌ`œK邩ǂƏڍדx̒iK邩ǂ
+  bool indexed(false), optimize(false), lod(false);
+
+  // IvV̉
+  int arg(1);
+  while (arg < argc && argv[arg][0] == '-')
+  {
+    if (strcmp(argv[arg], "-n") == 0 && arg + 1 < argc)
+    {
+      repeat = std::max(atoi(argv[arg + 1]), 1);
+      arg += 2;
+    }
+    else if (strcmp(argv[arg], "-t") == 0 && arg + 1 < argc)
+    {
+      threads = static_cast<unsigned int>(atoi(argv[arg + 1]));
+      arg += 2;
+    }
+    else if (strcmp(argv[arg], "-g") == 0 && arg + 1 < argc)
+    {
+      size = atoi(argv[arg + 1]);
+      arg += 2;
+    }
+    else if (strcmp(argv[arg], "-c") == 0)
+    {
+      cache = true;
+      ++arg;
+    }
+    else if (strcmp(argv[arg], "-i") == 0)
+    {
+      indexed = true;
+      ++arg;
+    }
+    else if (strcmp(argv[arg], "-o") == 0)
+    {
+      indexed = optimize = true;
+      ++arg;
+    }
+    else if (strcmp(argv[arg], "-l") == 0)
+    {
+      indexed = lod = true;
+      ++arg;
+    }
+    else
+    {
+      return usage(argv[0]);
+    }
+  }
+  if (argc - arg != 1) return usage(argv[0]);
+  const char *const name(argv[arg]);
+
+  // iq̌`쐬
+  if (size > 0 && !generate(name, size)) return 1;
+
+  // t@C̃TCY
+  std::ifstream file(name, std::ios::binary | std::ios::ate);
+  if (!file) return usage(argv[0]);
+  const double megabytes(double(file.tellg()) / 1048576.0);
+  file.close();
+
+  // ǂݍ݂ɎgXbhݒ肷
+  ggObjThreads(threads);
+
+  // ͂̑xvƂ̓bVLbVgȂ
+  ggObjCache(cache);
+
+  // `̍œK
+  ggMeshOptimize(optimize);
+
+  // ł
+  double best(1.0e30);
+  GLuint triangles(0);
+
+  for (int n = 0; n < repeat; ++n)
+  {
+    GLuint ng, nv;
+    GLuint (*group)[2];
+    GLfloat (*amb)[4], (*diff)[4], (*spec)[4], *shi;
+    GLfloat (*pos)[3], (*norm)[3];
+    GLuint nf, nl(1);
+    GLuint (*face)[3](nullptr);
+    GLfloat *error(nullptr);
+
+    // ǂݍݎԂv
+    const std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+    const bool status(lod
+      ? ggLoadObj(name, ng, group, amb, diff, spec, shi, nv, pos, norm, nl, error, nf, face, false)
+      : indexed
+      ? ggLoadObj(name, ng, group, amb, diff, spec, shi, nv, pos, norm, nf, face, false)
+      : ggLoadObj(name, ng, group, amb, diff, spec, shi, nv, pos, norm, false));
+    const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+    if (!status) return 1;
+
+    best = std::min(best, elapsed.count());
+    triangles = indexed ? nf : nv / 3;
+
+    // ڍדx̒iKƂ̎Op`ƌ덷\
+    if (lod)
+    {
+      triangles = 0;
+      for (GLuint g = 0; g < ng; ++g) triangles += group[g][1] / 3;
+      if (n == repeat - 1)
+      {
+        for (GLuint l = 0; l < nl; ++l)
+        {
+          GLuint count(0);
+          for (GLuint g = 0; g < ng; ++g) count += group[l * ng + g][1] / 3;
+          std::cout << "LOD " << l << ": " << count << " triangles, error " << error[l] << std::endl;
+        }
+      }
+    }
+
+    delete[] group;
+    delete[] amb;
+    delete[] diff;
+    delete[] spec;
+    delete[] shi;
+    delete[] pos;
+    delete[] norm;
+    delete[] face;
+    delete[] error;
+  }
+
+  // ʂ\
+  std::cout << std::fixed << std::setprecision(1)
+    << name << ": " << megabytes << " MB, " << triangles << " triangles, "
+    << best * 1000.0 << " ms, " << megabytes / best << " MB/s, "
+    << triangles / best * 1.0e-6 << " Mtriangles/s, peak RSS " << peakMegabytes() << " MB" << std::endl;
+
+  return 0;
+}